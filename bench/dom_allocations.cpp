@@ -0,0 +1,96 @@
+// Counts the heap allocations made while parsing a synthetic 500 link robot, once
+// with every TinyXML node and attribute allocated separately, once with the
+// nodes placed in the document arena and once with attribute values left in place.
+// Linked with urdfparser_allocation_hook.
+
+#include "urdf/allocations.h"
+#include "urdf/model.h"
+#include "synthetic_robot.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+struct Measurement {
+	long allocations;
+	long bytes;
+	double microseconds;
+};
+
+template<typename Fn>
+static Measurement measure(Fn fn, int repetitions) {
+	fn(); // warm up
+
+	urdf::AllocationTracker tracker;
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < repetitions; i++) {
+		fn();
+	}
+	auto end = std::chrono::steady_clock::now();
+	urdf::AllocationCounts total = tracker.report().total();
+
+	Measurement m;
+	m.allocations = static_cast<long>(total.allocations) / repetitions;
+	m.bytes = static_cast<long>(total.bytes) / repetitions;
+	m.microseconds = std::chrono::duration<double, std::micro>(end - start).count() / repetitions;
+	return m;
+}
+
+static void report(const char* name, const Measurement& m) {
+	std::printf("  %-28s %8ld mallocs %10ld bytes %10.1f us\n", name, m.allocations, m.bytes, m.microseconds);
+}
+
+int main(int argc, char** argv) {
+	int num_links = 500;
+	int repetitions = 20;
+	if (argc > 1) {
+		num_links = std::atoi(argv[1]);
+	}
+
+	const std::string xml_string = syntheticChainRobot(num_links);
+	std::printf("parsing a %d link robot (%zu bytes), average of %d runs\n",
+	            num_links, xml_string.size(), repetitions);
+
+	report("TinyXML DOM, heap nodes", measure([&]() {
+		TiXmlDocument doc;
+		doc.Parse(xml_string.c_str());
+	}, repetitions));
+
+	report("TinyXML DOM, arena nodes", measure([&]() {
+		TiXmlDocument doc;
+		doc.SetUseArena(true);
+		doc.Parse(xml_string.c_str());
+	}, repetitions));
+
+	report("TinyXML DOM, arena in situ", measure([&]() {
+		std::vector<char> buffer(xml_string.c_str(), xml_string.c_str() + xml_string.size() + 1);
+		TiXmlDocument doc;
+		doc.SetUseArena(true);
+		doc.ParseInSitu(buffer.data());
+	}, repetitions));
+
+	report("UrdfModel::fromUrdfStr", measure([&]() {
+		urdf::UrdfModel::fromUrdfStr(xml_string);
+	}, repetitions));
+
+	urdf::ParseOptions untracked;
+	untracked.track_locations = false;
+	report("UrdfModel, no locations", measure([&]() {
+		urdf::UrdfModel::fromUrdfStr(xml_string, untracked);
+	}, repetitions));
+
+	urdf::ParseOptions streaming;
+	streaming.streaming = true;
+	report("UrdfModel, streaming", measure([&]() {
+		urdf::UrdfModel::fromUrdfStr(xml_string, streaming);
+	}, repetitions));
+
+	urdf::ParseOptions parallel;
+	parallel.num_threads = 4;
+	report("UrdfModel, 4 threads", measure([&]() {
+		urdf::UrdfModel::fromUrdfStr(xml_string, parallel);
+	}, repetitions));
+
+	return 0;
+}
@@ -0,0 +1,52 @@
+// Throughput of batched forward kinematics on the synthetic chain robot, the
+// workload of a sampling planner checking many configurations at once.
+
+#include "urdf/model.h"
+#include "urdf/compiled_model.h"
+#include "urdf/kinematics.h"
+#include "synthetic_robot.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace urdf;
+
+int main(int argc, char** argv) {
+	int num_links = 50;
+	size_t num_configurations = 10000;
+	if (argc > 1) {
+		num_links = std::atoi(argv[1]);
+	}
+
+	auto model = UrdfModel::fromUrdfStr(syntheticChainRobot(num_links));
+	auto compiled = CompiledModel::fromUrdfModel(*model);
+
+	std::vector<double> q(num_configurations * compiled->numPositions());
+	for (size_t i = 0; i < q.size(); i++) {
+		q[i] = std::sin(0.37 * i);
+	}
+	std::vector<Transform> poses(num_configurations * compiled->numLinks());
+
+	forwardKinematics(*compiled, q.data(), num_configurations, poses.data()); // warm up
+
+	int repetitions = 10;
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < repetitions; r++) {
+		forwardKinematics(*compiled, q.data(), num_configurations, poses.data());
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	double seconds = std::chrono::duration<double>(end - start).count() / repetitions;
+	double checksum = 0.;
+	for (const Transform& pose : poses) {
+		checksum += pose.position.z;
+	}
+
+	std::printf("%d links, %zu configurations per call\n", num_links, num_configurations);
+	std::printf("  %10.1f configurations/s %10.1f ns per link pose (checksum %g)\n",
+	            num_configurations / seconds, seconds * 1e9 / (num_configurations * compiled->numLinks()), checksum);
+	return 0;
+}
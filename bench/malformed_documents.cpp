@@ -0,0 +1,64 @@
+// Rejects a set of small malformed robots, the way a service validating
+// uploaded URDF files spends most of its time, once through fromUrdfStr() and
+// its exceptions and once through tryFromUrdfStr(). The message is not read
+// in the second run, so it is never formatted.
+
+#include "urdf/model.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace urdf;
+
+template<typename Fn>
+static double microsecondsPerDocument(size_t num_documents, int repetitions, Fn fn) {
+	fn(); // warm up
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < repetitions; r++) {
+		fn();
+	}
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::micro>(end - start).count() / repetitions / num_documents;
+}
+
+int main() {
+	const std::string links =
+		"<link name=\"base\"><visual><geometry><box size=\"1 1 1\"/></geometry></visual></link>"
+		"<link name=\"arm\"><collision><geometry><cylinder length=\"1\" radius=\"0.1\"/></geometry></collision></link>";
+	const std::vector<std::string> documents = {
+		"<robot name=\"r\">" + links + "<link name=\"x\"><visual><geometry><box size=\"1 1\"/></geometry></visual></link></robot>",
+		"<robot name=\"r\">" + links + "<link name=\"x\"><inertial><mass value=\"heavy\"/></inertial></link></robot>",
+		"<robot name=\"r\">" + links + "<joint name=\"j\" type=\"revolute\"><parent link=\"base\"/><child link=\"arm\"/>"
+		"<limit effort=\"1\"/></joint></robot>",
+		"<robot name=\"r\">" + links + "<joint name=\"j\" type=\"fixed\"><parent link=\"base\"/><child link=\"hand\"/></joint></robot>",
+		"<robot name=\"r\">" + links + "</robot>",
+	};
+
+	const int repetitions = 2000;
+	size_t rejected = 0;
+
+	double throwing = microsecondsPerDocument(documents.size(), repetitions, [&]() {
+		for (const std::string& xml : documents) {
+			try {
+				UrdfModel::fromUrdfStr(xml);
+			} catch (const URDFParseError& e) {
+				rejected++;
+			}
+		}
+	});
+
+	double non_throwing = microsecondsPerDocument(documents.size(), repetitions, [&]() {
+		for (const std::string& xml : documents) {
+			if (!UrdfModel::tryFromUrdfStr(xml)) {
+				rejected++;
+			}
+		}
+	});
+
+	std::printf("rejecting %zu malformed robots, average of %d runs\n", documents.size(), repetitions);
+	std::printf("  %-28s %8.2f us per document\n", "fromUrdfStr, exception", throwing);
+	std::printf("  %-28s %8.2f us per document\n", "tryFromUrdfStr, ParseError", non_throwing);
+	return rejected == 0;
+}
@@ -0,0 +1,41 @@
+// Measures the heap memory a parsed 2000 link robot keeps alive and the time
+// UrdfModel::initLinkTree takes to connect its links. The names have the length
+// of real robot descriptions, too long for the small string buffer of std::string.
+// Linked with urdfparser_allocation_hook.
+
+#include "urdf/allocations.h"
+#include "urdf/model.h"
+#include "synthetic_robot.h"
+
+#include <chrono>
+#include <cstdio>
+
+using namespace urdf;
+
+int main() {
+	const int num_links = 2000;
+	const std::string xml = syntheticChainRobot(num_links, "right_arm_shoulder_assembly_");
+
+	AllocationTracker tracker;
+	std::shared_ptr<UrdfModel> model = UrdfModel::fromUrdfStr(xml);
+	long model_bytes = tracker.report().live_bytes;
+
+	const int repetitions = 50;
+	double seconds = 0.;
+	for (int r = 0; r < repetitions; r++) {
+		for (auto& entry : model->link_map) {
+			entry.second->child_links.clear();
+			entry.second->child_joints.clear();
+		}
+		map<Name, Name> parent_link_tree;
+		auto start = std::chrono::steady_clock::now();
+		model->initLinkTree(parent_link_tree);
+		auto end = std::chrono::steady_clock::now();
+		seconds += std::chrono::duration<double>(end - start).count();
+	}
+
+	std::printf("%d link robot, %zu bytes of URDF\n", num_links, xml.size());
+	std::printf("  heap held by the model  %10ld bytes\n", model_bytes);
+	std::printf("  initLinkTree            %10.1f us\n", seconds / repetitions * 1e6);
+	return 0;
+}
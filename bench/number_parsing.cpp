@@ -0,0 +1,82 @@
+// Micro benchmark for the cost of parsing a single <origin xyz="..." rpy="..."/>
+// element. It compares the previous boost::split + boost::lexical_cast based
+// vector parsing with the allocation free std::from_chars implementation that
+// is used by Transform::fromXml now.
+
+#include "urdf/common.h"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace urdf;
+
+static Vector3 legacyFromVecStr(const string& vector_str) {
+	vector<string> pieces;
+	vector<double> values;
+
+	boost::split(pieces, vector_str, boost::is_any_of(" "));
+	for (unsigned int i = 0; i < pieces.size(); ++i) {
+		if (pieces[i] != "") {
+			values.push_back(boost::lexical_cast<double>(pieces[i].c_str()));
+		}
+	}
+
+	if (values.size() != 3) {
+		throw URDFParseError("legacy parser found wrong number of elements");
+	}
+
+	return Vector3(values[0], values[1], values[2]);
+}
+
+static Transform legacyOrigin(const char* xyz_str, const char* rpy_str) {
+	Transform t;
+	t.position = legacyFromVecStr(xyz_str);
+	Vector3 rpy = legacyFromVecStr(rpy_str);
+	t.rotation = Rotation::fromRpy(rpy.x, rpy.y, rpy.z);
+	return t;
+}
+
+static Transform currentOrigin(const char* xyz_str, const char* rpy_str) {
+	Transform t;
+	t.position = Vector3::fromVecStr(xyz_str);
+	t.rotation = Rotation::fromRpyStr(rpy_str);
+	return t;
+}
+
+template<typename Fn>
+static double nanosecondsPerOrigin(Fn fn, long iterations, double &checksum) {
+	const char* xyz_str = "0.0823 -0.1526 1.25e-2";
+	const char* rpy_str = "1.5707963267949 0 -0.785398163397448";
+
+	auto start = std::chrono::steady_clock::now();
+	for (long i = 0; i < iterations; ++i) {
+		Transform t = fn(xyz_str, rpy_str);
+		checksum += t.position.x + t.rotation.w;
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+int main(int argc, char** argv) {
+	long iterations = 1000000;
+	if (argc > 1) {
+		iterations = std::atol(argv[1]);
+	}
+
+	double checksum = 0.;
+	double legacy = nanosecondsPerOrigin(legacyOrigin, iterations, checksum);
+	double current = nanosecondsPerOrigin(currentOrigin, iterations, checksum);
+
+	std::printf("origin parsing, %ld iterations\n", iterations);
+	std::printf("  boost::split + lexical_cast : %8.1f ns/origin\n", legacy);
+	std::printf("  std::from_chars             : %8.1f ns/origin\n", current);
+	std::printf("  speedup                     : %8.2fx\n", legacy / current);
+	std::printf("  (checksum %g)\n", checksum);
+
+	return 0;
+}
@@ -0,0 +1,82 @@
+// Compares transforming points by the quaternion form of a URDF origin with
+// transforming them by its cached 3x4 matrix, the way a collision checker
+// moves the vertices of every collision mesh into its link frame.
+
+#include "urdf/model.h"
+#include "synthetic_robot.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace urdf;
+
+template<typename Fn>
+static double nanosecondsPerPoint(size_t num_points, int repetitions, Fn fn) {
+	fn(); // warm up
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < repetitions; r++) {
+		fn();
+	}
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count() / repetitions / num_points;
+}
+
+int main() {
+	ParseOptions options;
+	options.cache_origin_matrices = true;
+	auto model = UrdfModel::fromUrdfStr(syntheticChainRobot(200), options);
+
+	std::vector<std::shared_ptr<Visual>> visuals;
+	for (auto& entry : model->link_map) {
+		for (auto& visual : entry.second->visuals) {
+			visuals.push_back(visual);
+		}
+	}
+
+	// a small mesh per visual, transformed one point at a time
+	const size_t points_per_mesh = 256;
+	std::vector<Vector3> mesh(points_per_mesh);
+	for (size_t i = 0; i < points_per_mesh; i++) {
+		mesh[i] = Vector3(std::sin(0.1 * i), std::cos(0.3 * i), 0.01 * i);
+	}
+	std::vector<Vector3> out(points_per_mesh);
+	size_t num_points = visuals.size() * points_per_mesh;
+	const int repetitions = 200;
+	double checksum = 0.;
+
+	double quaternion = nanosecondsPerPoint(num_points, repetitions, [&]() {
+		for (auto& visual : visuals) {
+			const Transform& origin = visual->origin;
+			for (size_t i = 0; i < points_per_mesh; i++) {
+				out[i] = origin * mesh[i];
+			}
+			checksum += out[0].x;
+		}
+	});
+
+	double matrix = nanosecondsPerPoint(num_points, repetitions, [&]() {
+		for (auto& visual : visuals) {
+			const Matrix3x4& origin = visual->origin_matrix.value();
+			for (size_t i = 0; i < points_per_mesh; i++) {
+				out[i] = origin * mesh[i];
+			}
+			checksum += out[0].x;
+		}
+	});
+
+	double matrix_batch = nanosecondsPerPoint(num_points, repetitions, [&]() {
+		for (auto& visual : visuals) {
+			transformPoints(visual->origin_matrix.value(), mesh.data(), out.data(), points_per_mesh);
+			checksum += out[0].x;
+		}
+	});
+
+	std::printf("%zu visual origins, %zu points each\n", visuals.size(), points_per_mesh);
+	std::printf("  quaternion Transform   %6.2f ns/point\n", quaternion);
+	std::printf("  cached Matrix3x4       %6.2f ns/point\n", matrix);
+	std::printf("  Matrix3x4 batch        %6.2f ns/point\n", matrix_batch);
+	std::printf("  (checksum %g)\n", checksum);
+	return 0;
+}
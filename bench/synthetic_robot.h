@@ -0,0 +1,158 @@
+#ifndef URDF_BENCH_SYNTHETIC_ROBOT_H
+#define URDF_BENCH_SYNTHETIC_ROBOT_H
+
+#include <sstream>
+#include <string>
+
+// Generates a deterministic URDF serial chain with num_links links. Every link has
+// an inertial, a mesh visual with a shared material and a box collision, every
+// joint is a revolute joint with limits and dynamics, so the document exercises
+// most of the parser. The link and joint names start with prefix.
+inline std::string syntheticChainRobot(int num_links, const std::string& prefix = "") {
+	std::ostringstream xml;
+	xml << "<?xml version=\"1.0\"?>\n"
+	    << "<robot name=\"synthetic_chain_" << num_links << "\">\n"
+	    << "  <material name=\"grey\">\n"
+	    << "    <color rgba=\"0.5 0.5 0.5 1.0\"/>\n"
+	    << "  </material>\n";
+
+	for (int i = 0; i < num_links; i++) {
+		xml << "  <link name=\"" << prefix << "link_" << i << "\">\n"
+		    << "    <inertial>\n"
+		    << "      <origin xyz=\"0.0" << i % 10 << " -0.012 0.1375\" rpy=\"0 0 0\"/>\n"
+		    << "      <mass value=\"" << 1.5 + (i % 7) * 0.25 << "\"/>\n"
+		    << "      <inertia ixx=\"0.0125\" ixy=\"0\" ixz=\"0\" iyy=\"0.0131\" iyz=\"0\" izz=\"0.0042\"/>\n"
+		    << "    </inertial>\n"
+		    << "    <visual>\n"
+		    << "      <origin xyz=\"0 0 0.1\" rpy=\"0 0 1.5707963267949\"/>\n"
+		    << "      <geometry>\n"
+		    << "        <mesh filename=\"package://synthetic/meshes/link_" << i << ".stl\" scale=\"0.001 0.001 0.001\"/>\n"
+		    << "      </geometry>\n"
+		    << "      <material name=\"grey\"/>\n"
+		    << "    </visual>\n"
+		    << "    <collision>\n"
+		    << "      <origin xyz=\"0 0 0.1\" rpy=\"0 0 0\"/>\n"
+		    << "      <geometry>\n"
+		    << "        <box size=\"0.08 0.08 0.25\"/>\n"
+		    << "      </geometry>\n"
+		    << "    </collision>\n"
+		    << "  </link>\n";
+
+		if (i > 0) {
+			xml << "  <joint name=\"" << prefix << "joint_" << i << "\" type=\"revolute\">\n"
+			    << "    <parent link=\"" << prefix << "link_" << i - 1 << "\"/>\n"
+			    << "    <child link=\"" << prefix << "link_" << i << "\"/>\n"
+			    << "    <origin xyz=\"0 0 0.2\" rpy=\"0 " << (i % 2 ? "1.5707963267949" : "0") << " 0\"/>\n"
+			    << "    <axis xyz=\"0 0 1\"/>\n"
+			    << "    <limit effort=\"150\" lower=\"-2.96705972839\" upper=\"2.96705972839\" velocity=\"1.7\"/>\n"
+			    << "    <dynamics damping=\"0.5\" friction=\"0.1\"/>\n"
+			    << "  </joint>\n";
+		}
+	}
+
+	xml << "</robot>\n";
+	return xml.str();
+}
+
+// Generates a deterministic URDF tree with num_links links, where link i hangs
+// from link (i - 1) / branching. A branching of 1 gives a chain, a branching of
+// num_links - 1 puts every link on the root. The links are kept small so the
+// document is dominated by the joints and the tree.
+inline std::string syntheticTreeRobot(int num_links, int branching) {
+	std::ostringstream xml;
+	xml << "<?xml version=\"1.0\"?>\n"
+	    << "<robot name=\"synthetic_tree_" << num_links << "_" << branching << "\">\n";
+
+	for (int i = 0; i < num_links; i++) {
+		xml << "  <link name=\"link_" << i << "\">\n"
+		    << "    <inertial>\n"
+		    << "      <mass value=\"" << 0.5 + (i % 5) * 0.1 << "\"/>\n"
+		    << "      <inertia ixx=\"0.001\" ixy=\"0\" ixz=\"0\" iyy=\"0.001\" iyz=\"0\" izz=\"0.001\"/>\n"
+		    << "    </inertial>\n"
+		    << "    <collision>\n"
+		    << "      <geometry>\n"
+		    << "        <sphere radius=\"0.0" << 1 + i % 9 << "\"/>\n"
+		    << "      </geometry>\n"
+		    << "    </collision>\n"
+		    << "  </link>\n";
+	}
+
+	for (int i = 1; i < num_links; i++) {
+		int parent = (i - 1) / branching;
+		int sibling = (i - 1) % branching;
+		xml << "  <joint name=\"joint_" << i << "\" type=\"" << (i % 3 ? "revolute" : "fixed") << "\">\n"
+		    << "    <parent link=\"link_" << parent << "\"/>\n"
+		    << "    <child link=\"link_" << i << "\"/>\n"
+		    << "    <origin xyz=\"0." << sibling % 10 << " 0 0.1\" rpy=\"0 0 " << sibling * 0.25 << "\"/>\n"
+		    << "    <axis xyz=\"0 1 0\"/>\n"
+		    << "    <limit effort=\"10\" lower=\"-1.57\" upper=\"1.57\" velocity=\"2\"/>\n"
+		    << "  </joint>\n";
+	}
+
+	xml << "</robot>\n";
+	return xml.str();
+}
+
+// Generates a deterministic URDF serial chain with num_links links that each
+// carry num_shapes visuals and as many collisions, cycling through meshes,
+// boxes, cylinders and spheres. The visuals use one of four shared materials
+// or an inline color, so the material lookups are exercised as well.
+inline std::string syntheticShapesRobot(int num_links, int num_shapes) {
+	static const char* const materials[] = { "grey", "blue", "orange", "black" };
+	static const char* const colors[] = { "0.5 0.5 0.5 1", "0 0 0.8 1", "1 0.4 0 1", "0 0 0 1" };
+
+	std::ostringstream xml;
+	xml << "<?xml version=\"1.0\"?>\n"
+	    << "<robot name=\"synthetic_shapes_" << num_links << "_" << num_shapes << "\">\n";
+	for (int m = 0; m < 4; m++) {
+		xml << "  <material name=\"" << materials[m] << "\"><color rgba=\"" << colors[m] << "\"/></material>\n";
+	}
+
+	for (int i = 0; i < num_links; i++) {
+		xml << "  <link name=\"link_" << i << "\">\n";
+		for (int s = 0; s < 2 * num_shapes; s++) {
+			bool visual = s < num_shapes;
+			int shape = i + s;
+			xml << (visual ? "    <visual name=\"" : "    <collision name=\"") << "shape_" << s << "\">\n"
+			    << "      <origin xyz=\"0 0 0." << s % 10 << "\" rpy=\"0 0 " << (s % 4) * 0.5 << "\"/>\n"
+			    << "      <geometry>\n";
+			switch (shape % 4) {
+				case 0:
+					xml << "        <mesh filename=\"package://synthetic/meshes/link_" << i << "_" << s << ".dae\""
+					    << " scale=\"0.001 0.001 0.001\"/>\n";
+					break;
+				case 1:
+					xml << "        <box size=\"0.1 0.0" << 1 + s % 9 << " 0.25\"/>\n";
+					break;
+				case 2:
+					xml << "        <cylinder length=\"0.2\" radius=\"0.0" << 1 + s % 9 << "\"/>\n";
+					break;
+				default:
+					xml << "        <sphere radius=\"0.0" << 1 + s % 9 << "\"/>\n";
+					break;
+			}
+			xml << "      </geometry>\n";
+			if (visual && shape % 5 == 4) {
+				xml << "      <material name=\"link_" << i << "_" << s << "\"><color rgba=\"0.1 0.2 0.3 1\"/></material>\n";
+			} else if (visual) {
+				xml << "      <material name=\"" << materials[shape % 4] << "\"/>\n";
+			}
+			xml << (visual ? "    </visual>\n" : "    </collision>\n");
+		}
+		xml << "  </link>\n";
+
+		if (i > 0) {
+			xml << "  <joint name=\"joint_" << i << "\" type=\"continuous\">\n"
+			    << "    <parent link=\"link_" << i - 1 << "\"/>\n"
+			    << "    <child link=\"link_" << i << "\"/>\n"
+			    << "    <origin xyz=\"0 0 0.3\"/>\n"
+			    << "    <axis xyz=\"0 0 1\"/>\n"
+			    << "  </joint>\n";
+		}
+	}
+
+	xml << "</robot>\n";
+	return xml.str();
+}
+
+#endif
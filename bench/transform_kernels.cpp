@@ -0,0 +1,69 @@
+// Rotates a cloud of mesh vertices with the previous two quaternion product
+// rotation, with the current Rotation::operator* and with the batch kernel.
+
+#include "urdf/common.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace urdf;
+
+static Vector3 legacyRotate(const Rotation& q, const Vector3& vec) {
+	Rotation t;
+	t.w = 0.0;
+	t.x = vec.x;
+	t.y = vec.y;
+	t.z = vec.z;
+	t = q * (t * q.getInverse());
+	return Vector3(t.x, t.y, t.z);
+}
+
+template<typename Fn>
+static void report(const char* name, size_t num_points, int repetitions, Fn fn) {
+	fn(); // warm up
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < repetitions; r++) {
+		fn();
+	}
+	auto end = std::chrono::steady_clock::now();
+	double seconds = std::chrono::duration<double>(end - start).count() / repetitions;
+	std::printf("  %-26s %8.1f Mpoints/s\n", name, num_points / seconds / 1e6);
+}
+
+int main() {
+	const size_t num_points = 1 << 20;
+	const int repetitions = 20;
+
+	std::vector<Vector3> points(num_points);
+	for (size_t i = 0; i < num_points; i++) {
+		points[i] = Vector3(std::sin(0.1 * i), std::cos(0.3 * i), 0.001 * i);
+	}
+	std::vector<Vector3> out(num_points);
+	Transform transform(Vector3(0.1, -0.2, 0.3), Rotation::fromRpy(0.3, -1.1, 2.4));
+
+	std::printf("transforming %zu points\n", num_points);
+	report("legacy quaternion products", num_points, repetitions, [&]() {
+		for (size_t i = 0; i < num_points; i++) {
+			Vector3 moved = legacyRotate(transform.rotation, points[i]);
+			out[i] = Vector3(moved.x + transform.position.x, moved.y + transform.position.y,
+			                 moved.z + transform.position.z);
+		}
+	});
+	report("Transform::operator*", num_points, repetitions, [&]() {
+		for (size_t i = 0; i < num_points; i++) {
+			out[i] = transform * points[i];
+		}
+	});
+	report("transformPoints", num_points, repetitions, [&]() {
+		transformPoints(transform, points.data(), out.data(), num_points);
+	});
+
+	double checksum = 0.;
+	for (const Vector3& p : out) {
+		checksum += p.x;
+	}
+	std::printf("  (checksum %g)\n", checksum);
+	return 0;
+}
@@ -0,0 +1,211 @@
+// Parses a fixed set of synthetic robots (chains, trees from wide to deep, and
+// links full of visuals and collisions) and reports for each the parse
+// throughput, the heap allocations and the peak heap use of one parse, and the
+// allocations by subsystem when the library tracks them. The robots are
+// generated the same way on every run, so the numbers of two builds can be
+// compared directly. Linked with urdfparser_allocation_hook.
+//
+//   urdf_bench [--json] [--repetitions N] [--filter TEXT]
+//
+// --json prints one JSON object with a "results" array instead of the table,
+// for the performance tracking to pick up.
+
+#include "urdf/model.h"
+#include "urdf/allocations.h"
+#include "synthetic_robot.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+using namespace urdf;
+
+// in the order of AllocationSubsystem
+static const char* const subsystem_names[NUM_ALLOCATION_SUBSYSTEMS] = {
+	"other", "xml_dom", "strings", "geometry", "maps",
+};
+
+struct Robot {
+	std::string name;
+	std::string xml;
+};
+
+struct Mode {
+	const char* name;
+	ParseOptions options;
+};
+
+struct Result {
+	std::string robot;
+	const char* mode;
+	size_t bytes;
+	size_t links;
+	size_t joints;
+	int repetitions;
+	double median_us;
+	double best_us;
+	double xml_us;
+	AllocationReport allocations;
+};
+
+static Result run(const Robot& robot, const Mode& mode, int repetitions) {
+	Result result;
+	result.robot = robot.name;
+	result.mode = mode.name;
+	result.bytes = robot.xml.size();
+	result.repetitions = repetitions;
+
+	// the allocations of one parse, the copy of the document included
+	std::shared_ptr<UrdfModel> model;
+	{
+		AllocationTracker tracker;
+		model = UrdfModel::fromUrdfStr(robot.xml, mode.options);
+		result.allocations = tracker.report();
+	}
+	result.links = model->link_map.size();
+	result.joints = model->joint_map.size();
+	model.reset();
+
+	std::vector<double> times;
+	ParseStats stats;
+	double xml_seconds = 0.;
+	for (int r = 0; r < repetitions; r++) {
+		auto start = std::chrono::steady_clock::now();
+		UrdfModel::fromUrdfStr(robot.xml, mode.options, &stats);
+		auto end = std::chrono::steady_clock::now();
+		times.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+		xml_seconds += stats.xml_seconds;
+	}
+	std::sort(times.begin(), times.end());
+	result.median_us = times[times.size() / 2];
+	result.best_us = times.front();
+	result.xml_us = xml_seconds * 1e6 / repetitions;
+	return result;
+}
+
+static double megabytesPerSecond(const Result& r) {
+	return r.bytes / r.median_us;
+}
+
+static double linksPerSecond(const Result& r) {
+	return r.links / r.median_us * 1e6;
+}
+
+static long maxResidentKilobytes() {
+#ifndef _WIN32
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+		return usage.ru_maxrss;
+	}
+#endif
+	return -1;
+}
+
+static void printTable(const std::vector<Result>& results) {
+	std::printf("  %-22s %-10s %10s %9s %9s %10s %10s %11s %10s",
+	            "robot", "mode", "bytes", "links", "MB/s", "links/s", "mallocs", "alloc bytes", "peak heap");
+	if (AllocationTracker::enabled) {
+		for (const char* name : subsystem_names) {
+			std::printf(" %9s", name);
+		}
+	}
+	std::printf("\n");
+	for (const Result& r : results) {
+		AllocationCounts total = r.allocations.total();
+		std::printf("  %-22s %-10s %10zu %9zu %9.1f %10.0f %10zu %11zu %10ld",
+		            r.robot.c_str(), r.mode, r.bytes, r.links, megabytesPerSecond(r), linksPerSecond(r),
+		            total.allocations, total.bytes, r.allocations.peak_live_bytes);
+		if (AllocationTracker::enabled) {
+			for (const AllocationCounts& counts : r.allocations.subsystems) {
+				std::printf(" %9zu", counts.allocations);
+			}
+		}
+		std::printf("\n");
+	}
+	std::printf("max resident set %ld kB, parse stats %s, allocation subsystems %s\n", maxResidentKilobytes(),
+	            ParseStats::enabled ? "on" : "off", AllocationTracker::enabled ? "on" : "off");
+}
+
+static void printJson(const std::vector<Result>& results) {
+	std::printf("{\n  \"benchmark\": \"urdf_bench\",\n  \"parse_stats\": %s,\n  \"allocation_subsystems\": %s,\n"
+	            "  \"max_rss_kb\": %ld,\n  \"results\": [\n",
+	            ParseStats::enabled ? "true" : "false", AllocationTracker::enabled ? "true" : "false",
+	            maxResidentKilobytes());
+	for (size_t i = 0; i < results.size(); i++) {
+		const Result& r = results[i];
+		AllocationCounts total = r.allocations.total();
+		std::printf("    {\"robot\": \"%s\", \"mode\": \"%s\", \"bytes\": %zu, \"links\": %zu, \"joints\": %zu, "
+		            "\"repetitions\": %d, \"median_us\": %.3f, \"best_us\": %.3f, \"xml_us\": %.3f, "
+		            "\"mb_per_s\": %.3f, \"links_per_s\": %.1f, \"allocations\": %zu, \"allocated_bytes\": %zu, "
+		            "\"peak_heap_bytes\": %ld, \"subsystems\": {",
+		            r.robot.c_str(), r.mode, r.bytes, r.links, r.joints, r.repetitions, r.median_us, r.best_us,
+		            r.xml_us, megabytesPerSecond(r), linksPerSecond(r), total.allocations, total.bytes,
+		            r.allocations.peak_live_bytes);
+		for (size_t s = 0; s < NUM_ALLOCATION_SUBSYSTEMS; s++) {
+			std::printf("%s\"%s\": {\"allocations\": %zu, \"bytes\": %zu}", s > 0 ? ", " : "", subsystem_names[s],
+			            r.allocations.subsystems[s].allocations, r.allocations.subsystems[s].bytes);
+		}
+		std::printf("}}%s\n", i + 1 < results.size() ? "," : "");
+	}
+	std::printf("  ]\n}\n");
+}
+
+int main(int argc, char** argv) {
+	bool json = false;
+	int repetitions = 20;
+	const char* filter = "";
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--json") == 0) {
+			json = true;
+		} else if (std::strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc) {
+			repetitions = std::max(1, std::atoi(argv[++i]));
+		} else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+			filter = argv[++i];
+		} else {
+			std::fprintf(stderr, "usage: %s [--json] [--repetitions N] [--filter TEXT]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	const std::vector<Robot> robots = {
+		{ "chain_50", syntheticChainRobot(50) },
+		{ "chain_1000", syntheticChainRobot(1000) },
+		{ "tree_1000_binary", syntheticTreeRobot(1000, 2) },
+		{ "tree_1000_wide", syntheticTreeRobot(1000, 32) },
+		{ "star_1000", syntheticTreeRobot(1000, 999) },
+		{ "shapes_100x8", syntheticShapesRobot(100, 8) },
+		{ "shapes_20x64", syntheticShapesRobot(20, 64) },
+	};
+
+	std::vector<Mode> modes(2);
+	modes[0].name = "dom";
+	modes[1].name = "streaming";
+	modes[1].options.streaming = true;
+
+	std::vector<Result> results;
+	for (const Robot& robot : robots) {
+		for (const Mode& mode : modes) {
+			std::string name = robot.name + "/" + mode.name;
+			if (name.find(filter) == std::string::npos) {
+				continue;
+			}
+			results.push_back(run(robot, mode, repetitions));
+		}
+	}
+
+	if (json) {
+		printJson(results);
+	} else {
+		std::printf("parsing synthetic robots, median of %d runs\n", repetitions);
+		printTable(results);
+	}
+	return 0;
+}
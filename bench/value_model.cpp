@@ -0,0 +1,98 @@
+// Compares walking every collision shape of a 2000 link robot through the
+// shared_ptr objects of a UrdfModel with walking the ValueModel, and counts the
+// heap blocks each representation keeps alive. Linked with urdfparser_allocation_hook.
+
+#include "urdf/allocations.h"
+#include "urdf/model.h"
+#include "urdf/value_model.h"
+#include "synthetic_robot.h"
+
+#include <chrono>
+#include <cstdio>
+
+using namespace urdf;
+
+static double volume(const Geometry& geometry) {
+	switch (geometry.type) {
+		case GeometryType::SPHERE: {
+			double r = static_cast<const Sphere&>(geometry).radius;
+			return 4. / 3. * M_PI * r * r * r;
+		}
+		case GeometryType::BOX: {
+			const Vector3& d = static_cast<const Box&>(geometry).dim;
+			return d.x * d.y * d.z;
+		}
+		case GeometryType::CYLINDER: {
+			const Cylinder& c = static_cast<const Cylinder&>(geometry);
+			return M_PI * c.radius * c.radius * c.length;
+		}
+		case GeometryType::CAPSULE: {
+			const Capsule& c = static_cast<const Capsule&>(geometry);
+			return M_PI * c.radius * c.radius * (c.length + 4. / 3. * c.radius);
+		}
+		default:
+			return 0.;
+	}
+}
+
+template<typename Fn>
+static double microseconds(int repetitions, Fn fn) {
+	fn(); // warm up
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < repetitions; r++) {
+		fn();
+	}
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::micro>(end - start).count() / repetitions;
+}
+
+int main() {
+	const std::string xml = syntheticChainRobot(2000);
+	// the names are interned once per process, keep them out of the count
+	UrdfModel::fromUrdfStr(xml);
+
+	std::shared_ptr<UrdfModel> model;
+	long model_blocks;
+	{
+		AllocationTracker tracker;
+		model = UrdfModel::fromUrdfStr(xml);
+		model_blocks = tracker.report().live_blocks;
+	}
+
+	ValueModel values;
+	long value_blocks;
+	{
+		AllocationTracker tracker;
+		values = ValueModel::fromUrdfModel(*model);
+		value_blocks = tracker.report().live_blocks;
+	}
+
+	const int repetitions = 2000;
+	double total = 0.;
+
+	double shared = microseconds(repetitions, [&]() {
+		for (auto& entry : model->link_map) {
+			for (auto& collision : entry.second->collisions) {
+				if (collision->geometry.has_value()) {
+					total += volume(*collision->geometry.value());
+				}
+			}
+		}
+	});
+
+	double by_value = microseconds(repetitions, [&]() {
+		for (const LinkValue& link : values.links) {
+			for (const CollisionValue& collision : link.collisions) {
+				if (collision.geometry.has_value()) {
+					total += std::visit([](const Geometry& geometry) { return volume(geometry); }, *collision.geometry);
+				}
+			}
+		}
+	});
+
+	std::printf("%zu links\n", values.links.size());
+	std::printf("  UrdfModel   %8ld heap blocks %8.1f us per pass over all collisions\n", model_blocks, shared);
+	std::printf("  ValueModel  %8ld heap blocks %8.1f us per pass over all collisions\n", value_blocks, by_value);
+	std::printf("  (checksum %g)\n", total);
+	return 0;
+}
@@ -47,6 +47,7 @@ distribution.
 #ifdef TIXML_USE_STL
 	#include <string>
  	#include <iostream>
+	#include <mutex>
 	#include <sstream>
 	#define TIXML_STRING		std::string
 #else
@@ -82,6 +83,7 @@ distribution.
 #endif	
 
 class TiXmlDocument;
+class TiXmlNode;
 class TiXmlElement;
 class TiXmlComment;
 class TiXmlUnknown;
@@ -100,10 +102,11 @@ const int TIXML_PATCH_VERSION = 2;
 struct TiXmlCursor
 {
 	TiXmlCursor()		{ Clear(); }
-	void Clear()		{ row = col = -1; }
+	void Clear()		{ row = col = offset = -1; }
 
 	int row;	// 0 based.
 	int col;	// 0 based.
+	int offset;	// Byte offset from the start of the parsed text, also kept when rows are not tracked.
 };
 
 
@@ -151,6 +154,33 @@ public:
 	virtual bool Visit( const TiXmlUnknown& /*unknown*/ )			{ return true; }
 };
 
+/**
+	Receives elements while a document is being parsed, which allows the DOM to be
+	processed piece by piece instead of building the whole tree first.
+
+	ElementParsed() is called as soon as an element has been read completely,
+	including all of its children, and before it is linked to its parent. The
+	depth of the root element is 1. Return KEEP to add the element to the
+	document as usual, DISCARD to delete it right away, or STOP to discard it and
+	end parsing with TIXML_ERROR_PARSING_STOPPED.
+
+	@sa TiXmlDocument::SetParseListener()
+*/
+class TiXmlParseListener
+{
+public:
+	enum Result
+	{
+		KEEP,
+		DISCARD,
+		STOP
+	};
+
+	virtual ~TiXmlParseListener() {}
+
+	virtual Result ElementParsed( const TiXmlNode* parent, TiXmlElement* element, int depth ) = 0;
+};
+
 // Only used by Attribute::Query functions
 enum 
 { 
@@ -170,6 +200,53 @@ enum TiXmlEncoding
 
 const TiXmlEncoding TIXML_DEFAULT_ENCODING = TIXML_ENCODING_UNKNOWN;
 
+/**
+	A bump allocator for the nodes and attributes of a TiXmlDocument. Memory is
+	handed out from a few large blocks, which are only released as a whole when
+	the arena is destroyed. Deleting a node that lives in an arena runs its
+	destructor but does not give the memory back.
+
+	@sa TiXmlDocument::SetUseArena()
+*/
+class TiXmlArena
+{
+public:
+	TiXmlArena() : blocks( 0 ), current( 0 ), remaining( 0 ), nextBlockSize( FIRST_BLOCK_SIZE ), blockCount( 0 ) {}
+	~TiXmlArena()	{ Release(); }
+
+	/// Returns size bytes aligned to ALIGNMENT, never null.
+	void* Allocate( size_t size );
+
+	/// Frees all blocks. Only valid once nothing allocated from the arena is used anymore.
+	void Release();
+
+	/// Number of blocks taken from the heap so far.
+	size_t BlockCount() const	{ return blockCount; }
+
+	enum
+	{
+		ALIGNMENT = 16,
+		FIRST_BLOCK_SIZE = 8 * 1024,
+		MAX_BLOCK_SIZE = 1024 * 1024
+	};
+
+private:
+	TiXmlArena( const TiXmlArena& );			// not allowed.
+	void operator=( const TiXmlArena& );		// not allowed.
+
+	struct Block
+	{
+		Block* next;
+	};
+
+	Block*	blocks;
+	char*	current;
+	size_t	remaining;
+	size_t	nextBlockSize;
+	size_t	blockCount;
+};
+
+
 /** TiXmlBase is a base class for every class in TinyXml.
 	It does little except to establish that TinyXml classes
 	can be printed and provide some utility functions.
@@ -202,6 +279,16 @@ public:
 	TiXmlBase()	:	userData(0)		{}
 	virtual ~TiXmlBase()			{}
 
+	/*	Nodes and attributes can be placed in the TiXmlArena of a document. Every
+		allocation remembers where it came from, so delete works the same for
+		nodes from the heap and from an arena. Passing a null arena allocates
+		from the heap.
+	*/
+	static void* operator new( size_t size );
+	static void* operator new( size_t size, TiXmlArena* arena );
+	static void operator delete( void* p );
+	static void operator delete( void* p, TiXmlArena* arena );
+
 	/**	All TinyXml classes can print themselves to a filestream
 		or the string class (TiXmlString in non-STL mode, std::string
 		in STL mode.) Either or both cfile and str can be null.
@@ -239,11 +326,15 @@ public:
 
 		There is a minor performance cost to computing the row and column. Computation
 		can be disabled if TiXmlDocument::SetTabSize() is called with 0 as the value.
+		ByteOffset() is still recorded then, and TiXmlDocument::LocationOf() turns it
+		back into a row and column.
 
 		@sa TiXmlDocument::SetTabSize()
 	*/
 	int Row() const			{ return location.row + 1; }
 	int Column() const		{ return location.col + 1; }	///< See Row()
+	/// Byte offset of the node in the parsed text, -1 if it was not parsed.
+	int ByteOffset() const	{ return location.offset; }
 
 	void  SetUserData( void* user )			{ userData = user; }	///< Set a pointer to arbitrary user data.
 	void* GetUserData()						{ return userData; }	///< Get a pointer to arbitrary user data.
@@ -280,6 +371,7 @@ public:
 		TIXML_ERROR_EMBEDDED_NULL,
 		TIXML_ERROR_PARSING_CDATA,
 		TIXML_ERROR_DOCUMENT_TOP_ONLY,
+		TIXML_ERROR_PARSING_STOPPED,
 
 		TIXML_ERROR_STRING_COUNT
 	};
@@ -786,6 +878,7 @@ public:
 	TiXmlAttribute() : TiXmlBase()
 	{
 		document = 0;
+		insituValue = 0;
 		prev = next = 0;
 	}
 
@@ -795,6 +888,7 @@ public:
 	{
 		name = _name;
 		value = _value;
+		insituValue = 0;
 		document = 0;
 		prev = next = 0;
 	}
@@ -805,14 +899,24 @@ public:
 	{
 		name = _name;
 		value = _value;
+		insituValue = 0;
 		document = 0;
 		prev = next = 0;
 	}
 
 	const char*		Name()  const		{ return name.c_str(); }		///< Return the name of this attribute.
-	const char*		Value() const		{ return value.c_str(); }		///< Return the value of this attribute.
+	const char*		Value() const		{ return insituValue ? insituValue : value.c_str(); }	///< Return the value of this attribute.
 	#ifdef TIXML_USE_STL
-	const std::string& ValueStr() const	{ return value; }				///< Return the value of this attribute.
+	/// Return the value of this attribute. A value that lives in an in situ
+	/// parsed buffer is copied into the attribute once, on first use, and the
+	/// copy is kept, so threads can call this on a shared DOM. Value() keeps
+	/// pointing into the buffer and never copies.
+	const std::string& ValueStr() const
+	{
+		if ( insituValue )
+			std::call_once( valueCopied, [this]() { value = insituValue; } );
+		return value;
+	}
 	#endif
 	int				IntValue() const;									///< Return the value of this attribute, converted to an integer.
 	double			DoubleValue() const;								///< Return the value of this attribute, converted to a double.
@@ -834,7 +938,7 @@ public:
 	int QueryDoubleValue( double* _value ) const;
 
 	void SetName( const char* _name )	{ name = _name; }				///< Set the name of this attribute.
-	void SetValue( const char* _value )	{ value = _value; }				///< Set the value.
+	void SetValue( const char* _value )	{ value = _value; insituValue = 0; }	///< Set the value.
 
 	void SetIntValue( int _value );										///< Set the value from an integer.
 	void SetDoubleValue( double _value );								///< Set the value from a double.
@@ -843,7 +947,7 @@ public:
 	/// STL std::string form.
 	void SetName( const std::string& _name )	{ name = _name; }	
 	/// STL std::string form.	
-	void SetValue( const std::string& _value )	{ value = _value; }
+	void SetValue( const std::string& _value )	{ value = _value; insituValue = 0; }
 	#endif
 
 	/// Get the next sibling attribute in the DOM. Returns null at end.
@@ -881,9 +985,20 @@ private:
 	TiXmlAttribute( const TiXmlAttribute& );				// not implemented.
 	void operator=( const TiXmlAttribute& base );	// not allowed.
 
+	// Finds the closing quote of an attribute value that can be used in place, or
+	// returns null if the value contains entities that have to be decoded.
+	static const char* FindInSituValueEnd( const char* p, char quote, TiXmlEncoding encoding );
+
 	TiXmlDocument*	document;	// A pointer back to a document, for error reporting.
 	TIXML_STRING name;
-	TIXML_STRING value;
+	// Also the copy of an in situ value made by ValueStr().
+	mutable TIXML_STRING value;
+	// Points into the buffer given to TiXmlDocument::ParseInSitu(), null if the
+	// value is owned by 'value'.
+	const char* insituValue;
+	#ifdef TIXML_USE_STL
+	mutable std::once_flag valueCopied;
+	#endif
 	TiXmlAttribute*	prev;
 	TiXmlAttribute*	next;
 };
@@ -960,6 +1075,12 @@ public:
 	*/
 	const char* Attribute( const char* name ) const;
 
+	/** Looks up several attributes with a single walk over the attribute list.
+		values[i] is set to the value of the attribute called names[i], or null if
+		none exists. Returns the number of names that were found.
+	*/
+	int Attributes( const char* const* names, const char** values, int count ) const;
+
 	/** Given an attribute name, Attribute() returns the value
 		for the attribute of that name, or null if none exists.
 		If the attribute exists and can be converted to an integer,
@@ -1051,9 +1172,13 @@ public:
 	void SetAttribute( const char* name, const char * _value );
 
     #ifdef TIXML_USE_STL
+	/// STL std::string forms, see TiXmlAttribute::ValueStr().
 	const std::string* Attribute( const std::string& name ) const;
 	const std::string* Attribute( const std::string& name, int* i ) const;
 	const std::string* Attribute( const std::string& name, double* d ) const;
+	/// The value of the attribute without copying it out of an in situ parsed
+	/// buffer, like Attribute( const char* ). Null if there is no such attribute.
+	const char* AttributeValue( const std::string& name ) const;
 	int QueryIntAttribute( const std::string& name, int* _value ) const;
 	int QueryDoubleAttribute( const std::string& name, double* _value ) const;
 
@@ -1407,7 +1532,8 @@ public:
 	TiXmlDocument( const TiXmlDocument& copy );
 	TiXmlDocument& operator=( const TiXmlDocument& copy );
 
-	virtual ~TiXmlDocument() {}
+	// The children have to go before the arena they may live in.
+	virtual ~TiXmlDocument() { Clear(); }
 
 	/** Load a file using the current document value.
 		Returns true if successful. Will delete any existing
@@ -1446,6 +1572,16 @@ public:
 	*/
 	virtual const char* Parse( const char* p, TiXmlParsingData* data = 0, TiXmlEncoding encoding = TIXML_DEFAULT_ENCODING );
 
+	/** Parse the given null terminated block of xml data in place. Attribute values
+		that need no entity decoding are not copied, they point straight into the
+		buffer, whose closing quotes are overwritten with terminating zeros. The
+		buffer therefore has to be writable and has to outlive the document.
+	*/
+	const char* ParseInSitu( char* p, TiXmlParsingData* data = 0, TiXmlEncoding encoding = TIXML_DEFAULT_ENCODING );
+
+	/// [internal use] True while ParseInSitu() is running.
+	bool ParsingInSitu() const	{ return parsingInSitu; }
+
 	/** Get the root element -- the only top level element -- of the document.
 		In well formed XML, there should only be one. TinyXml is tolerant of
 		multiple elements at the document level.
@@ -1477,6 +1613,7 @@ public:
 	*/
 	int ErrorRow() const	{ return errorLocation.row+1; }
 	int ErrorCol() const	{ return errorLocation.col+1; }	///< The column where the error occured. See ErrorRow()
+	int ErrorOffset() const	{ return errorLocation.offset; }	///< The byte offset of the error, -1 if unknown. See ErrorRow()
 
 	/** SetTabSize() allows the error reporting functions (ErrorRow() and ErrorCol())
 		to report the correct values for row and column. It does not change the output
@@ -1489,7 +1626,9 @@ public:
 
 		The tab size is required for calculating the location of nodes. If not
 		set, the default of 4 is used. The tabsize is set per document. Setting
-		the tabsize to 0 disables row/column tracking.
+		the tabsize to 0 disables row/column tracking, which saves a second pass
+		over the text. Errors are still located: their row and column are counted
+		from the byte offset once the error occurs.
 
 		Note that row and column tracking is not supported when using operator>>.
 
@@ -1506,6 +1645,34 @@ public:
 
 	int TabSize() const	{ return tabsize; }
 
+	/** Counts the row and column of the byte at 'offset' in the text 'start' that
+		was parsed, with the same rules the parser uses while tracking locations.
+		Meant for documents parsed with a tab size of 0, see ByteOffset().
+	*/
+	TiXmlCursor LocationOf( const char* start, int offset, TiXmlEncoding encoding = TIXML_DEFAULT_ENCODING ) const;
+
+	/** SetParseListener() installs a listener that is handed every element as soon
+		as it has been parsed. The listener is not owned by the document and has to
+		stay alive until parsing is done. Pass null to remove it.
+
+		@sa TiXmlParseListener
+	*/
+	void SetParseListener( TiXmlParseListener* listener )	{ parseListener = listener; }
+
+	TiXmlParseListener* ParseListener() const	{ return parseListener; }
+
+	/** SetUseArena() makes Parse() allocate all nodes and attributes from a
+		document owned TiXmlArena instead of one heap allocation each. The memory
+		is released in one step when the document is destroyed, but nodes that are
+		deleted earlier do not give their memory back. This suits documents that
+		are parsed, read and thrown away, not documents that are edited a lot.
+		Needs to be set before parsing.
+	*/
+	void SetUseArena( bool use )	{ useArena = use; }
+
+	/// The arena nodes are allocated from while parsing, null if arenas are disabled.
+	TiXmlArena* Arena()				{ return useArena ? &arena : 0; }
+
 	/** If you have handled the error, it can be reset with this call. The error
 		state is automatically cleared if you Parse a new XML block.
 	*/
@@ -1553,6 +1720,10 @@ private:
 	int tabsize;
 	TiXmlCursor errorLocation;
 	bool useMicrosoftBOM;		// the UTF-8 BOM were found when read. Note this, and try to write.
+	TiXmlParseListener* parseListener;
+	bool parsingInSitu;
+	bool useArena;
+	TiXmlArena arena;
 };
 
 
@@ -0,0 +1,110 @@
+#ifndef URDF_ALLOCATIONS_H
+#define URDF_ALLOCATIONS_H
+
+#include <cstddef>
+
+namespace urdf {
+
+	/// The part of the parser a heap allocation is made for.
+	enum class AllocationSubsystem {
+		OTHER,     // link, joint and material objects, the copy of the document, ...
+		XML_DOM,   // TinyXML nodes, attributes and arena blocks
+		STRINGS,   // interned names and the other strings of the model
+		GEOMETRY,  // the shapes of visuals and collisions
+		MAPS,      // the name maps of the model and the link tree
+	};
+
+	static const size_t NUM_ALLOCATION_SUBSYSTEMS = 5;
+
+	struct AllocationCounts {
+		size_t allocations;
+		size_t bytes;
+	};
+
+	/// Allocations counted by an AllocationTracker, by subsystem.
+	struct AllocationReport {
+		AllocationCounts subsystems[NUM_ALLOCATION_SUBSYSTEMS];
+		/// Change in the number and size of the live blocks, of any subsystem.
+		/// Back at zero if everything allocated since the tracker started was
+		/// freed again. Blocks allocated while no tracker was alive are not
+		/// counted, neither when they are allocated nor when they are freed.
+		long live_blocks;
+		long live_bytes;
+		/// Highest live_bytes reached. Every new tracker starts the peak over,
+		/// so with nested trackers the outer one only sees the peak since the
+		/// inner one started.
+		long peak_live_bytes;
+
+		const AllocationCounts& operator[](AllocationSubsystem subsystem) const {
+			return subsystems[static_cast<size_t>(subsystem)];
+		}
+
+		AllocationCounts total() const;
+	};
+
+	/// Counts the heap allocations of every thread from its construction on,
+	/// for example to keep the allocations of a model load within a budget:
+	///
+	///     AllocationTracker tracker;
+	///     UrdfModel::fromUrdfFile(path);
+	///     AllocationReport report = tracker.report();
+	///
+	/// Allocations are only seen if the program is linked with the
+	/// urdfparser_allocation_hook target, which replaces the global operator
+	/// new, see hooked(). They are put into subsystems if the library is built
+	/// with URDF_TRACK_ALLOCATIONS, otherwise they are all OTHER.
+	class AllocationTracker {
+		public:
+#ifdef URDF_TRACK_ALLOCATIONS
+			static constexpr bool enabled = true;
+#else
+			static constexpr bool enabled = false;
+#endif
+
+			AllocationTracker();
+			~AllocationTracker();
+			AllocationTracker(const AllocationTracker&) = delete;
+			AllocationTracker& operator=(const AllocationTracker&) = delete;
+
+			/// The allocations since construction.
+			AllocationReport report() const;
+
+			/// True if the allocation hook is linked into the program.
+			static bool hooked();
+
+			/// Called by the hook for every allocation, returns whether it was
+			/// counted. Only the counted blocks are passed to release() once they
+			/// are freed.
+			static bool record(size_t bytes);
+			static void release(size_t bytes);
+
+		private:
+			AllocationReport start;
+	};
+
+	/// Books the allocations of the current thread to subsystem until it goes
+	/// out of scope. Compiles to nothing without URDF_TRACK_ALLOCATIONS.
+	class AllocationScope {
+		public:
+#ifdef URDF_TRACK_ALLOCATIONS
+			explicit AllocationScope(AllocationSubsystem subsystem) : previous(current) {
+				current = subsystem;
+			}
+			~AllocationScope() { current = previous; }
+#else
+			explicit AllocationScope(AllocationSubsystem) {}
+#endif
+			AllocationScope(const AllocationScope&) = delete;
+			AllocationScope& operator=(const AllocationScope&) = delete;
+
+		private:
+			friend class AllocationTracker;
+			static thread_local AllocationSubsystem current;
+#ifdef URDF_TRACK_ALLOCATIONS
+			AllocationSubsystem previous;
+#endif
+	};
+
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 #include <math.h>
 #ifndef M_PI
 #define M_PI 3.141592538
@@ -12,11 +13,23 @@
 #include <memory>
 
 #include "urdf/exception.h"
+#include "urdf/parse_error.h"
 
 using namespace std;
 
 namespace urdf {
 
+	/// Parses a single double from str, ignoring surrounding whitespace.
+	/// Returns false if str does not hold exactly one valid number.
+	bool parseDouble(const char* str, double& value);
+
+	/// Parses a whitespace separated list of doubles from str without allocating.
+	/// At most max_values numbers are stored in values, but every token is counted
+	/// so the caller can report how many elements were found. Parsing stops at the
+	/// first token that is not a valid double; it is returned through bad_token.
+	size_t parseDoubles(const char* str, double* values, size_t max_values,
+	                    string_view* bad_token = nullptr);
+
 	struct Vector3 {
 		double x;
 		double y;
@@ -34,7 +47,10 @@ namespace urdf {
 		Vector3(const Vector3 &other) : x(other.x), y(other.y), z(other.z) {}
 		Vector3() : x(0.), y(0.), z(0.) {}
 
+		static Vector3 fromVecStr(const char* vector_str);
 		static Vector3 fromVecStr(const string& vector_str);
+		/// Does not throw, returns false and describes the problem in error.
+		static bool fromVecStr(const char* vector_str, Vector3& vector, ParseError& error);
 	};
 
 	struct Rotation {
@@ -55,6 +71,8 @@ namespace urdf {
 		Rotation getInverse() const;
 
 		Rotation operator*( const Rotation &other ) const;
+		/// Rotates vec. Costs a few multiplies instead of two quaternion products,
+		/// and the quaternion does not have to be normalized.
 		Vector3 operator*(const Vector3& vec) const;
 
 		Rotation(double x, double y, double z, double w) : x(x), y(y), z(z), w(w) {}
@@ -62,7 +80,9 @@ namespace urdf {
 		Rotation() : x(0.), y(0.), z(0.), w(1.) {}
 
 		static Rotation fromRpy(double roll, double pitch, double yaw);
+		static Rotation fromRpyStr(const char* rotation_str);
 		static Rotation fromRpyStr(const string &rotation_str);
+		static bool fromRpyStr(const char* rotation_str, Rotation& rotation, ParseError& error);
 	};
 
 	struct Color {
@@ -82,7 +102,9 @@ namespace urdf {
 		Color(float r, float g, float b, float a) : r(r), g(g), b(b), a(a) {}
 		Color(const Color& other) : r(other.r), g(other.g), b(other.b), a(other.a) {}
 
+		static Color fromColorStr(const char* vector_str);
 		static Color fromColorStr(const std::string &vector_str);
+		static bool fromColorStr(const char* vector_str, Color& color, ParseError& error);
 	};
 
 	struct Transform {
@@ -95,11 +117,50 @@ namespace urdf {
 		};
 
 		Transform() : position(Vector3()), rotation(Rotation()) {}
+		Transform(const Vector3& position, const Rotation& rotation) : position(position), rotation(rotation) {}
 		Transform(const Transform& other) : position(other.position), rotation(other.rotation) {}
 
+		/// Composition, other is applied first: (a * b) * p == a * (b * p).
+		Transform operator*(const Transform& other) const;
+		/// Transforms a point.
+		Vector3 operator*(const Vector3& point) const;
+		Transform getInverse() const;
+
 		static Transform fromXml(TiXmlElement* xml);
+		static bool fromXml(TiXmlElement* xml, Transform& transform, ParseError& error);
 	};
 
+	/// Rigid transform as a row major 3x4 homogeneous matrix: a rotation matrix
+	/// with the translation as fourth column. Transforming a point costs nine
+	/// multiplies, so it is the faster form for points transformed repeatedly.
+	struct Matrix3x4 {
+		double m[12];
+
+		Matrix3x4() : m{ 1., 0., 0., 0.,  0., 1., 0., 0.,  0., 0., 1., 0. } {}
+
+		/// Composition, other is applied first.
+		Matrix3x4 operator*(const Matrix3x4& other) const;
+		Vector3 operator*(const Vector3& point) const;
+
+		static Matrix3x4 fromTransform(const Transform& transform);
+	};
+
+	// Batch kernels over arrays. They work on a rotation matrix computed once per
+	// call (or per element for the transform arrays) and keep every loop free of
+	// branches and aliasing, so the compiler vectorizes them with SSE2 or AVX,
+	// see URDF_NATIVE_ARCH. in and out may be the same array but must not
+	// otherwise overlap.
+
+	/// out[i] = rotation * in[i]
+	void rotateVectors(const Rotation& rotation, const Vector3* in, Vector3* out, size_t count);
+	/// out[i] = transform * in[i]
+	void transformPoints(const Transform& transform, const Vector3* in, Vector3* out, size_t count);
+	void transformPoints(const Matrix3x4& transform, const Vector3* in, Vector3* out, size_t count);
+	/// out[i] = a[i] * b[i]
+	void composeTransforms(const Transform* a, const Transform* b, Transform* out, size_t count);
+	/// out[i] = in[i].getInverse()
+	void invertTransforms(const Transform* in, Transform* out, size_t count);
+
 
 	struct Twist {
 		Vector3  linear;
@@ -0,0 +1,79 @@
+#ifndef URDF_COMPILED_MODEL_H
+#define URDF_COMPILED_MODEL_H
+
+#include <memory>
+#include <vector>
+
+#include "urdf/common.h"
+#include "urdf/joint.h"
+#include "urdf/link.h"
+
+namespace urdf {
+
+	struct UrdfModel;
+
+	/// Flat, index based form of the kinematic tree of a UrdfModel.
+	///
+	/// Links are stored in topological order, so every parent comes before its
+	/// children and the root link has index 0. Each non root link i is moved by
+	/// exactly one joint, which is stored at index i - 1, so joint j always has
+	/// link j + 1 as its child. All per link and per joint data lives in
+	/// contiguous arrays, so kinematics and dynamics code can loop over them
+	/// instead of walking the shared_ptr tree.
+	struct CompiledModel {
+		// per link data, indexed by link index, see UrdfModel::assignIndices().
+		// links and joints are empty in the compiled tree of a FrozenModel.
+		std::vector<std::shared_ptr<Link>> links;
+		std::vector<int> link_parent;         // -1 for the root link
+		std::vector<int> link_parent_joint;   // -1 for the root link
+
+		// per joint data, indexed by joint index
+		std::vector<std::shared_ptr<Joint>> joints;
+		std::vector<int> joint_parent_link;
+		std::vector<int> joint_child_link;
+		std::vector<JointType> joint_type;
+		std::vector<Vector3> joint_axis;
+		std::vector<Transform> joint_origin;
+		// first entry of the joint in the joint position vector, see jointPositionCount()
+		std::vector<int> joint_position_index;
+
+		// length of a joint position vector, the positions of all joints in joint order
+		size_t num_positions;
+
+		size_t numLinks() const { return link_parent.size(); }
+		size_t numJoints() const { return joint_type.size(); }
+		size_t numPositions() const { return num_positions; }
+
+		/// Number of joint position values a joint of the given type takes:
+		/// one for revolute, continuous and prismatic joints, none for fixed
+		/// joints, x y z qx qy qz qw for floating joints (the quaternion is
+		/// normalized when used), and for planar joints two translations in
+		/// the plane normal to the axis and a rotation about it.
+		static int jointPositionCount(JointType type);
+
+		void clear() {
+			links.clear();
+			link_parent.clear();
+			link_parent_joint.clear();
+
+			joints.clear();
+			joint_parent_link.clear();
+			joint_child_link.clear();
+			joint_type.clear();
+			joint_axis.clear();
+			joint_origin.clear();
+			joint_position_index.clear();
+			num_positions = 0;
+		}
+
+		CompiledModel() { clear(); }
+
+		/// Builds the flat tree. The model is only read, so several threads may
+		/// compile the same model at once; UrdfModel::assignIndices() stores the
+		/// indices in the links and joints.
+		static std::shared_ptr<CompiledModel> fromUrdfModel(const UrdfModel& model);
+	};
+
+}
+
+#endif
@@ -7,15 +7,33 @@
 namespace urdf {
   class URDFParseError: public std::exception {
     std::string text;
+    int offset;
+    int line_number;
+    int column_number;
 
     public:
       URDFParseError(const std::string &error_msg) : std::exception() {
         text = error_msg;
+        offset = line_number = column_number = -1;
+      }
+
+      /// Error about the part of the document that starts at byte 'offset', line
+      /// and column are 1 based and appended to the message.
+      URDFParseError(const std::string &error_msg, int offset, int line, int column) : std::exception() {
+        text = error_msg + " (line " + std::to_string(line) + ", column " + std::to_string(column) + ")";
+        this->offset = offset;
+        line_number = line;
+        column_number = column;
       }
 
       virtual const char* what() const noexcept {
         return text.c_str();
       }
+
+      /// Byte offset in the document the error was found at, -1 if unknown.
+      int byteOffset() const { return offset; }
+      int line() const { return line_number; }
+      int column() const { return column_number; }
   };
 }
 
@@ -0,0 +1,87 @@
+#ifndef URDF_FROZEN_MODEL_H
+#define URDF_FROZEN_MODEL_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "urdf/compiled_model.h"
+#include "urdf/model.h"
+#include "urdf/value_model.h"
+
+namespace urdf {
+
+	/// Immutable snapshot of a UrdfModel, see UrdfModel::freeze().
+	///
+	/// The snapshot holds the model in value form, see ValueModel, and the
+	/// index arrays of its compiled tree, and keeps no Link, Joint or Material
+	/// of the model it was made from. Everything reachable from a FrozenModel is
+	/// therefore const: links name their children, parents and joints by index
+	/// instead of through shared_ptrs, and visuals, collisions and joint
+	/// properties are held by value. Any number of threads can read one
+	/// FrozenModel concurrently without locking, and reading does not touch
+	/// shared_ptr reference counts.
+	///
+	/// The pointers and references stay valid as long as the FrozenModel lives.
+	class FrozenModel {
+		public:
+			const std::string& getName() const { return values.name; }
+			const LinkValue* getRoot() const { return values.links.empty() ? nullptr : &values.links[0]; }
+
+			/// nullptr if the model has no element of that name. The names are
+			/// looked up in hash tables built by freeze(), not in maps.
+			const LinkValue* getLink(std::string_view name) const;
+			const JointValue* getJoint(std::string_view name) const;
+			const Material* getMaterial(std::string_view name) const;
+
+			/// Links and joints by their index in the compiled tree, see
+			/// ValueModel. Materials are numbered in the order of the model's
+			/// material_map, followed by those only used by a single visual.
+			size_t numLinks() const { return values.links.size(); }
+			size_t numJoints() const { return values.joints.size(); }
+			size_t numMaterials() const { return materials->size(); }
+			const LinkValue* linkAt(size_t index) const { return &values.links[index]; }
+			const JointValue* jointAt(size_t index) const { return &values.joints[index]; }
+			const Material* materialAt(size_t index) const { return &(*materials)[index]; }
+
+			/// Index of the named element, or -1 if there is none. Resolve names
+			/// once and keep the indices, e.g. to map the joint names of a
+			/// controller to positions in a joint position vector.
+			int linkIndex(std::string_view name) const { return values.linkIndex(name); }
+			int jointIndex(std::string_view name) const { return values.jointIndex(name); }
+			int materialIndex(std::string_view name) const { return values.materialIndex(name); }
+
+			/// nullptr for the root link.
+			const LinkValue* getParentLink(const LinkValue& link) const;
+			const JointValue* getParentJoint(const LinkValue& link) const;
+
+			/// The material of a visual, nullptr if it has none.
+			const Material* getMaterial(const VisualValue& visual) const;
+
+			/// The index arrays of the tree, for kinematics. Its links and
+			/// joints are empty, use linkAt() and jointAt() instead.
+			const CompiledModel& getCompiledModel() const { return compiled; }
+
+			/// Estimate of the memory held by the model, the object itself
+			/// included. Materials shared with other models are counted in full.
+			size_t memoryUsage() const;
+
+		private:
+			friend struct UrdfModel;
+			friend class UrdfLoader;
+			explicit FrozenModel(const UrdfModel& model);
+
+			FrozenModel(const FrozenModel&) = delete;
+			FrozenModel& operator=(const FrozenModel&) = delete;
+
+			// values.materials is moved into materials, which models with the
+			// same materials may share, see LoaderOptions::share_materials
+			ValueModel values;
+			std::shared_ptr<const std::vector<Material>> materials;
+			CompiledModel compiled;
+	};
+
+}
+
+#endif
@@ -24,6 +24,8 @@ namespace urdf {
 			Geometry(GeometryType type): type(type) {}
 
 			static std::shared_ptr<Geometry> fromXml(TiXmlElement* xml);
+			/// Reports problems to errors instead of throwing, returns nullptr then.
+			static std::shared_ptr<Geometry> fromXml(TiXmlElement* xml, ParseErrors& errors);
 	};
 
 	class Sphere : public Geometry {
@@ -37,6 +39,7 @@ namespace urdf {
 			Sphere() : radius(0.), Geometry(GeometryType::SPHERE) {}
 
 			static std::shared_ptr<Sphere> fromXml(TiXmlElement* xml);
+			static std::shared_ptr<Sphere> fromXml(TiXmlElement* xml, ParseErrors& errors);
 	};
 
 	class Box : public Geometry {
@@ -50,6 +53,7 @@ namespace urdf {
 			Box() : Geometry(GeometryType::BOX) {}
 
 			static std::shared_ptr<Box> fromXml(TiXmlElement* xml);
+			static std::shared_ptr<Box> fromXml(TiXmlElement* xml, ParseErrors& errors);
 	};
 
 	class Cylinder : public Geometry {
@@ -65,6 +69,7 @@ namespace urdf {
 			Cylinder() : length(0.), radius(0.), Geometry(GeometryType::CYLINDER) {}
 
 			static std::shared_ptr<Cylinder> fromXml(TiXmlElement* xml);
+			static std::shared_ptr<Cylinder> fromXml(TiXmlElement* xml, ParseErrors& errors);
 	};
     
     class Capsule : public Geometry {
@@ -80,6 +85,7 @@ namespace urdf {
             Capsule() : length(0.), radius(0.), Geometry(GeometryType::CAPSULE) {}
             
             static std::shared_ptr<Capsule> fromXml(TiXmlElement* xml);
+            static std::shared_ptr<Capsule> fromXml(TiXmlElement* xml, ParseErrors& errors);
     };
 
 	class Mesh : public Geometry {
@@ -98,6 +104,7 @@ namespace urdf {
 			Mesh() : scale(Vector3(1., 1., 1.)), Geometry(GeometryType::MESH) {}
 
 			static std::shared_ptr<Mesh> fromXml(TiXmlElement* xml);
+			static std::shared_ptr<Mesh> fromXml(TiXmlElement* xml, ParseErrors& errors);
 	};
 }
 
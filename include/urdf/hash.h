@@ -0,0 +1,15 @@
+#ifndef URDF_HASH_H
+#define URDF_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace urdf {
+
+	/// 64 bit XXH64 hash of size bytes at data. The result does not depend on the
+	/// byte order of the host, so it can be stored in files and compared later.
+	uint64_t hash64(const void* data, size_t size, uint64_t seed = 0);
+
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include "tinyxml/txml.h"
 
 #include "urdf/common.h"
+#include "urdf/name.h"
 
 namespace urdf{
 	struct JointDynamics {
@@ -22,6 +23,8 @@ namespace urdf{
 		JointDynamics(const JointDynamics& jd) : damping(jd.damping), friction(jd.friction) {}
 
 		static std::shared_ptr<JointDynamics> fromXml(TiXmlElement* xml);
+		/// Reports problems to errors instead of throwing, returns nullptr then.
+		static std::shared_ptr<JointDynamics> fromXml(TiXmlElement* xml, ParseErrors& errors);
 	};
 
 	struct JointLimits {
@@ -42,6 +45,7 @@ namespace urdf{
                                          effort(jl.effort), velocity(jl.velocity) {}
 
 		static std::shared_ptr<JointLimits> fromXml(TiXmlElement* xml);
+		static std::shared_ptr<JointLimits> fromXml(TiXmlElement* xml, ParseErrors& errors);
 	};
 
 	struct JointSafety {
@@ -62,6 +66,7 @@ namespace urdf{
                                          k_position(js.k_position), k_velocity(js.k_velocity) {}
 
 		static std::shared_ptr<JointSafety> fromXml(TiXmlElement* xml);
+		static std::shared_ptr<JointSafety> fromXml(TiXmlElement* xml, ParseErrors& errors);
 	};
 
 	struct JointCalibration {
@@ -76,10 +81,11 @@ namespace urdf{
 		JointCalibration() { clear(); }
 		JointCalibration(const JointCalibration& jc): rising(jc.rising), falling(jc.falling) {}
 		static std::shared_ptr<JointCalibration> fromXml(TiXmlElement* xml);
+		static std::shared_ptr<JointCalibration> fromXml(TiXmlElement* xml, ParseErrors& errors);
 	};
 
 	struct JointMimic {
-		std::string joint_name;
+		Name joint_name;
 		double offset;
 		double multiplier;
 
@@ -93,6 +99,7 @@ namespace urdf{
 		JointMimic(const JointMimic& mimic): joint_name(mimic.joint_name), offset(mimic.offset),
                                          multiplier(mimic.multiplier) {}
 		static std::shared_ptr<JointMimic> fromXml(TiXmlElement* xml);
+		static std::shared_ptr<JointMimic> fromXml(TiXmlElement* xml, ParseErrors& errors);
 	};
 
 	enum JointType {
@@ -106,12 +113,14 @@ namespace urdf{
 	};
 
 	struct Joint {
-		std::string name;
+		Name name;
 		JointType type;
 		Vector3 axis;
-		std::string child_link_name;
-		std::string parent_link_name;
+		Name child_link_name;
+		Name parent_link_name;
 		Transform parent_to_joint_transform;
+		// parent_to_joint_transform as a matrix, see UrdfModel::cacheOriginMatrices()
+		std::optional<Matrix3x4> parent_to_joint_matrix;
 
 		std::optional<std::shared_ptr<JointDynamics>> dynamics;
 		std::optional<std::shared_ptr<JointLimits>> limits;
@@ -119,17 +128,22 @@ namespace urdf{
 		std::optional<std::shared_ptr<JointCalibration>> calibration;
 		std::optional<std::shared_ptr<JointMimic>> mimic;
 
+		// position of the joint in the CompiledModel, -1 until the model is compiled
+		int joint_index;
+
 		void clear() {
 			this->axis.clear();
 			this->child_link_name.clear();
 			this->parent_link_name.clear();
 			this->parent_to_joint_transform.clear();
+			this->parent_to_joint_matrix.reset();
 
 			this->dynamics.reset();
 			this->limits.reset();
 			this->safety.reset();
 			this->calibration.reset();
 			this->type = JointType::UNKNOWN;
+			this->joint_index = -1;
 		}
 
 		Joint() : type(JointType::UNKNOWN) { clear(); }
@@ -137,10 +151,13 @@ namespace urdf{
                                axis(joint.axis), child_link_name(joint.child_link_name),
                                parent_link_name(joint.parent_link_name),
                                parent_to_joint_transform(joint.parent_to_joint_transform),
+                               parent_to_joint_matrix(joint.parent_to_joint_matrix),
                                dynamics(joint.dynamics), limits(joint.limits), safety(joint.safety),
-                               calibration(joint.calibration), mimic(joint.mimic) {}
+                               calibration(joint.calibration), mimic(joint.mimic),
+                               joint_index(joint.joint_index) {}
 
 		static std::shared_ptr<Joint> fromXml(TiXmlElement* xml);
+		static std::shared_ptr<Joint> fromXml(TiXmlElement* xml, ParseErrors& errors);
   };
 }
 
@@ -0,0 +1,32 @@
+#ifndef URDF_KINEMATICS_H
+#define URDF_KINEMATICS_H
+
+#include <vector>
+
+#include "urdf/common.h"
+#include "urdf/compiled_model.h"
+
+namespace urdf {
+
+	/// Computes the world pose of every link of a compiled model.
+	///
+	/// q holds CompiledModel::numPositions() joint positions, each joint's values
+	/// starting at CompiledModel::joint_position_index. link_poses receives
+	/// numLinks() transforms in link order; the root link is placed at the
+	/// origin. Because links are stored in topological order, every parent pose
+	/// is known before its children are computed, so a single pass suffices.
+	void forwardKinematics(const CompiledModel& model, const double* q, Transform* link_poses);
+
+	/// Batched form for many configurations at once. q holds num_configurations
+	/// position vectors back to back, and link_poses receives one block of
+	/// numLinks() poses per configuration in the same order.
+	void forwardKinematics(const CompiledModel& model, const double* q, size_t num_configurations,
+	                       Transform* link_poses);
+
+	/// Allocating form for a single configuration. Throws std::invalid_argument
+	/// if q does not have numPositions() values.
+	std::vector<Transform> forwardKinematics(const CompiledModel& model, const std::vector<double>& q);
+
+}
+
+#endif
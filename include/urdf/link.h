@@ -9,10 +9,11 @@
 #include "urdf/joint.h"
 #include "urdf/geometry.h"
 #include "urdf/common.h"
+#include "urdf/name.h"
 
 namespace urdf{
 	struct Material {
-		std::string name;
+		Name name;
 		std::string texture_filename;
 		Color color;
 
@@ -27,16 +28,21 @@ namespace urdf{
                                  color(m.color) {}
 
 		static std::shared_ptr<Material> fromXml(TiXmlElement* xml, bool);
+		/// Reports problems to errors instead of throwing, returns nullptr then.
+		static std::shared_ptr<Material> fromXml(TiXmlElement* xml, bool only_name_is_ok, ParseErrors& errors);
 	};
 
 
 	struct Inertial {
 		Transform origin;
+		// origin as a matrix, see UrdfModel::cacheOriginMatrices()
+		std::optional<Matrix3x4> origin_matrix;
 		double mass;
 		double ixx,ixy,ixz,iyy,iyz,izz;
 
 		void clear() {
 			origin.clear();
+			origin_matrix.reset();
 			mass = 0.;
 			ixx = 0.;
 			ixy = 0.;
@@ -47,22 +53,26 @@ namespace urdf{
 		}
 
 		Inertial() : mass(0.), ixx(0.), ixy(0.), ixz(0.), iyy(0.), iyz(0.), izz(0.) {}
-		Inertial(const Inertial& i) : origin(i.origin), ixx(i.ixx), ixy(i.ixy), ixz(i.ixz),
+		Inertial(const Inertial& i) : origin(i.origin), origin_matrix(i.origin_matrix), ixx(i.ixx), ixy(i.ixy), ixz(i.ixz),
                                   iyy(i.iyy), iyz(i.iyz), izz(i.izz), mass(i.mass) {}
 
 		static Inertial fromXml(TiXmlElement* xml);
+		static std::optional<Inertial> fromXml(TiXmlElement* xml, ParseErrors& errors);
 	};
 
 	struct Visual {
 		std::string name;
-		std::string material_name;
+		Name material_name;
 		Transform origin;
+		// origin as a matrix, see UrdfModel::cacheOriginMatrices()
+		std::optional<Matrix3x4> origin_matrix;
 
 		std::optional<std::shared_ptr<Geometry>> geometry;
 		std::optional<std::shared_ptr<Material>> material;
 
 		void clear() {
 			origin.clear();
+			origin_matrix.reset();
 			name.clear();
 			material_name.clear();
 
@@ -72,33 +82,41 @@ namespace urdf{
 
 		Visual() { this->clear(); }
 		Visual(const Visual& v) : name(v.name), material_name(v.material_name),
-                              origin(v.origin), geometry(v.geometry), material(v.material) {}
+                              origin(v.origin), origin_matrix(v.origin_matrix), geometry(v.geometry),
+                              material(v.material) {}
 
 		static std::shared_ptr<Visual> fromXml(TiXmlElement* xml);
+		static std::shared_ptr<Visual> fromXml(TiXmlElement* xml, ParseErrors& errors);
 	};
 
 	struct Collision {
 		std::string name;
 		Transform origin;
+		// origin as a matrix, see UrdfModel::cacheOriginMatrices()
+		std::optional<Matrix3x4> origin_matrix;
 		std::optional<std::shared_ptr<Geometry>> geometry;
 
 		void clear() {
 			name.clear();
 			origin.clear();
+			origin_matrix.reset();
 
 			geometry.reset();
 		}
 
 		Collision() { this->clear(); }
-		Collision(const Collision& c) : name(c.name), origin(c.origin), geometry(c.geometry) {}
+		Collision(const Collision& c) : name(c.name), origin(c.origin), origin_matrix(c.origin_matrix),
+                                    geometry(c.geometry) {}
 
 		static std::shared_ptr<Collision> fromXml(TiXmlElement* xml);
+		static std::shared_ptr<Collision> fromXml(TiXmlElement* xml, ParseErrors& errors);
 	};
 
+	/// Name of the link the element is part of, empty if it has none.
 	const char* getParentLinkName(TiXmlElement* xml);
 
 	struct Link {
-		std::string name;
+		Name name;
 
 		std::optional<Inertial> inertial;
 
@@ -106,15 +124,17 @@ namespace urdf{
 		std::vector<std::shared_ptr<Visual>>  visuals;
 
 		std::shared_ptr<Joint> parent_joint;
-		std::shared_ptr<Link> parent_link;
+		// non-owning, the parent owns its children through child_links
+		std::weak_ptr<Link> parent_link;
 
 		std::vector<std::shared_ptr<Joint>> child_joints;
 		std::vector<std::shared_ptr<Link>> child_links;
 
+		// position of the link in the CompiledModel, -1 until the model is compiled
 		int link_index;
 
 		std::shared_ptr<Link> getParent() const {
-			return parent_link;
+			return parent_link.lock();
 		}
 
 		void setParentLink(std::shared_ptr<Link> parent) {
@@ -137,7 +157,7 @@ namespace urdf{
 			inertial.reset();
 
 			parent_joint = nullptr;
-			parent_link = nullptr;
+			parent_link.reset();
 		}
 
 		Link() { this->clear(); }
@@ -147,6 +167,7 @@ namespace urdf{
                           child_links(l.child_links), link_index(l.link_index) {}
 
 		static std::shared_ptr<Link> fromXml(TiXmlElement *xml);
+		static std::shared_ptr<Link> fromXml(TiXmlElement *xml, ParseErrors& errors);
 	};
 
 }
@@ -0,0 +1,116 @@
+#ifndef URDF_LOADER_H
+#define URDF_LOADER_H
+
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "urdf/frozen_model.h"
+#include "urdf/model.h"
+
+namespace urdf {
+
+	class WorkStealingPool;
+
+	/// Options of an UrdfLoader.
+	struct LoaderOptions {
+		/// Number of worker threads, 0 for one per core.
+		unsigned int num_threads;
+
+		/// Options every document is parsed with. Each document is parsed on a
+		/// single worker, so parse.num_threads is ignored.
+		ParseOptions parse;
+
+		/// Let frozen models with identical materials, same names, colors and
+		/// textures in the same order, point at one table of materials instead
+		/// of each holding a copy, see loadFrozenFile(). Models loaded as
+		/// UrdfModel can be modified and never share anything.
+		bool share_materials;
+
+		LoaderOptions() : num_threads(0), share_materials(true) {}
+	};
+
+	/// How long loading one document took.
+	struct LoadTiming {
+		std::string source;     // the file path, or "string <n>" for the n-th string loaded
+		size_t bytes;
+		double wait_seconds;    // from the request until a worker started on it
+		double parse_seconds;
+		bool succeeded;
+	};
+
+	/// Loads many URDF documents concurrently on a bounded pool of worker threads.
+	///
+	///     UrdfLoader loader;
+	///     auto models = loader.loadFiles(paths);
+	///     for (auto& model : models) { use(model.get()); }
+	///
+	/// A failed load stores its URDFParseError in the future. The loader can be
+	/// used from several threads at once; destroying it waits for the loads that
+	/// are still queued. Models that are only read, for example the robots of
+	/// many scenes, are best loaded frozen, which lets them share materials.
+	class UrdfLoader {
+		public:
+			explicit UrdfLoader(const LoaderOptions& options = LoaderOptions());
+			~UrdfLoader();
+
+			std::future<std::shared_ptr<UrdfModel>> loadFile(const std::string& path);
+			std::future<std::shared_ptr<UrdfModel>> loadString(std::string xml_string);
+
+			std::vector<std::future<std::shared_ptr<UrdfModel>>> loadFiles(const std::vector<std::string>& paths);
+			std::vector<std::future<std::shared_ptr<UrdfModel>>> loadStrings(const std::vector<std::string>& xml_strings);
+
+			/// Loads the documents and freezes them, see UrdfModel::freeze().
+			std::future<std::shared_ptr<const FrozenModel>> loadFrozenFile(const std::string& path);
+			std::future<std::shared_ptr<const FrozenModel>> loadFrozenString(std::string xml_string);
+
+			std::vector<std::future<std::shared_ptr<const FrozenModel>>> loadFrozenFiles(const std::vector<std::string>& paths);
+			std::vector<std::future<std::shared_ptr<const FrozenModel>>> loadFrozenStrings(const std::vector<std::string>& xml_strings);
+
+			/// Timings of the finished loads, in the order they were requested.
+			/// They are kept until takeTimings() is called.
+			std::vector<LoadTiming> timings() const;
+			/// The same, but also forgets them, so a long running loader that
+			/// reports its timings now and then does not keep every one.
+			std::vector<LoadTiming> takeTimings();
+
+			size_t numThreads() const;
+
+			/// Number of distinct material tables held by frozen models that
+			/// are still alive, see LoaderOptions::share_materials.
+			size_t numMaterialTables() const;
+
+		private:
+			UrdfLoader(const UrdfLoader&) = delete;
+			UrdfLoader& operator=(const UrdfLoader&) = delete;
+
+			struct Request;
+			void submit(std::shared_ptr<Request> request);
+			std::shared_ptr<const FrozenModel> freeze(const UrdfModel& model);
+			std::shared_ptr<const std::vector<Material>> shareMaterials(std::shared_ptr<const std::vector<Material>> table);
+
+			LoaderOptions options;
+
+			mutable std::mutex mutex;
+			// timings of the finished loads not taken yet, by request number;
+			// a load that is still running keeps its timing in its Request
+			std::map<size_t, LoadTiming> finished_timings;
+			size_t num_requests;
+			size_t num_strings;
+			// material tables of the frozen models by hash, see LoaderOptions::share_materials.
+			// Tables of models that are gone are dropped whenever the map has doubled.
+			std::unordered_multimap<uint64_t, std::weak_ptr<const std::vector<Material>>> material_tables;
+			size_t material_tables_sweep;
+
+			// declared last, so the workers are joined before the members they use go away
+			std::unique_ptr<WorkStealingPool> pool;
+	};
+
+}
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef URDF_MAPPED_FILE_H
+#define URDF_MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+
+#include "urdf/exception.h"
+
+namespace urdf {
+
+	/// View of a whole file that is mapped into memory instead of being copied. The
+	/// mapping is always followed by at least one zero byte, so data() can be handed
+	/// to parsers that expect a null terminated string.
+	///
+	/// A writable mapping is private: writes go to copy-on-write pages and never
+	/// reach the file.
+	class MappedFile {
+		public:
+			explicit MappedFile(const std::string& path, bool writable = false);
+			~MappedFile();
+
+			const char* data() const { return data_; }
+			/// Only valid for writable mappings.
+			char* mutableData() { return writable_ ? data_ : nullptr; }
+			size_t size() const { return size_; }
+
+		private:
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			char* data_;
+			size_t size_;
+			bool writable_;
+			size_t mapping_size_;
+#ifdef _WIN32
+			std::string buffer_;
+#endif
+	};
+
+}
+
+#endif
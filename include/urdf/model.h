@@ -1,11 +1,14 @@
 #ifndef URDF_MODEL_H
 #define URDF_MODEL_H
 
+#include <cstdint>
 #include <string>
 #include <map>
 
 #include "urdf/common.h"
 #include "urdf/exception.h"
+#include "urdf/parse_error.h"
+#include "urdf/parse_stats.h"
 #include "urdf/link.h"
 #include "urdf/joint.h"
 
@@ -13,23 +16,66 @@ using namespace std;
 
 namespace urdf {
 
+	class FrozenModel;
+	struct CompiledModel;
+
+	/// Options that change how a URDF document is read.
+	struct ParseOptions {
+		/// Convert materials, links and joints while the document is read, as soon
+		/// as their element is closed, and drop the element again instead of
+		/// building the complete DOM first. Peak memory is then the model plus a
+		/// single element, and the document is walked only once.
+		bool streaming;
+
+		/// Keep track of the line and column of every element while parsing.
+		/// Turning this off skips a second scan over the text; the location of
+		/// an error is then counted from its byte offset once it is thrown.
+		bool track_locations;
+
+		/// Cache every joint, visual, collision and inertial origin as a 3x4
+		/// matrix once the model is loaded, see UrdfModel::cacheOriginMatrices().
+		bool cache_origin_matrices;
+
+		/// Number of threads converting the link and joint elements once the DOM
+		/// is built, 0 for one per core. The model, and the first error thrown
+		/// for a broken document, are the same as with a single thread. Pays off
+		/// for documents with thousands of links; ignored when streaming.
+		unsigned int num_threads;
+
+		ParseOptions() : streaming(false), track_locations(true), cache_origin_matrices(false), num_threads(1) {}
+	};
+
 	struct UrdfModel {
 		string name;
 		std::shared_ptr<Link> root_link;
 
-		map<string, std::shared_ptr<Link>> link_map;
-		map<string, std::shared_ptr<Joint>> joint_map;
-		map<string, std::shared_ptr<Material>> material_map;
+		// keyed by interned names, but ordered by their text, and std::less<> lets
+		// find() take a plain string without interning it
+		map<Name, std::shared_ptr<Link>, std::less<>> link_map;
+		map<Name, std::shared_ptr<Joint>, std::less<>> joint_map;
+		map<Name, std::shared_ptr<Material>, std::less<>> material_map;
 
 		const string& getName() const { return name; }
 		std::shared_ptr<Link> getRoot() const { return root_link; }
 
-		std::shared_ptr<Link> getLink(const string& name);
-		std::shared_ptr<Joint> getJoint(const string& name);
-		std::shared_ptr<Material> getMaterial(const string& name);
+		std::shared_ptr<Link> getLink(const string& name) const;
+		std::shared_ptr<Joint> getJoint(const string& name) const;
+		std::shared_ptr<Material> getMaterial(const string& name) const;
 
 		void getLinks(vector<std::shared_ptr<Link>>& linklist) const;
 
+		/// Add a parsed element to the model, throws an URDFParseError on duplicates.
+		/// addLink also resolves the materials used by the link's visuals, so all
+		/// global materials have to be added before.
+		void addMaterial(std::shared_ptr<Material> material);
+		void addLink(std::shared_ptr<Link> link);
+		void addJoint(std::shared_ptr<Joint> joint);
+		/// Report the problems to errors instead, return false if the element was
+		/// not added.
+		bool addMaterial(std::shared_ptr<Material> material, ParseErrors& errors);
+		bool addLink(std::shared_ptr<Link> link, ParseErrors& errors);
+		bool addJoint(std::shared_ptr<Joint> joint, ParseErrors& errors);
+
 		void clear() {
 			name.clear();
 
@@ -43,12 +89,100 @@ namespace urdf {
 		};
 
 
-		void initLinkTree(map<string, string>& parent_link_tree);
-		void findRoot(const map<string, string> &parent_link_tree);
+		/// Stores the Matrix3x4 form next to the origin of every joint, visual,
+		/// collision and inertial, so hot loops can multiply matrices instead of
+		/// converting the quaternion every time. Call it again after changing an
+		/// origin.
+		void cacheOriginMatrices();
+
+		/// Compiles the model and stores the index of every link and joint in
+		/// the compiled tree in Link::link_index and Joint::joint_index. Unlike
+		/// CompiledModel::fromUrdfModel() this writes to the links and joints,
+		/// so it must not run while other threads use the model.
+		std::shared_ptr<CompiledModel> assignIndices();
+
+		/// Copies the model by value into an immutable snapshot that many
+		/// threads can read at once without locking. Later changes to this
+		/// model do not reach the snapshot. Throws URDFParseError if the model
+		/// has no valid link tree.
+		std::shared_ptr<const FrozenModel> freeze() const;
+
+		void initLinkTree(map<Name, Name>& parent_link_tree);
+		void findRoot(const map<Name, Name> &parent_link_tree);
+		bool initLinkTree(map<Name, Name>& parent_link_tree, ParseErrors& errors);
+		bool findRoot(const map<Name, Name> &parent_link_tree, ParseErrors& errors);
 
 		UrdfModel() { clear(); }
 
-		static std::shared_ptr<UrdfModel> fromUrdfStr(const std::string& xml_string);
+		/// stats, if given, is filled with the time of each phase and the size
+		/// of the document, see ParseStats.
+		static std::shared_ptr<UrdfModel> fromUrdfStr(const std::string& xml_string,
+		                                              const ParseOptions& options = ParseOptions(),
+		                                              ParseStats* stats = nullptr);
+
+		/// Loads a URDF file by mapping it into memory read only. The mapping is
+		/// parsed directly, only the attribute values are copied out of it.
+		static std::shared_ptr<UrdfModel> fromUrdfFile(const std::string& path,
+		                                               const ParseOptions& options = ParseOptions(),
+		                                               ParseStats* stats = nullptr);
+
+		/// Parses a null terminated URDF document without writing to it, the
+		/// attribute values are copied out of the buffer.
+		static std::shared_ptr<UrdfModel> fromUrdfBuffer(const char* xml_buffer,
+		                                                 const ParseOptions& options = ParseOptions(),
+		                                                 ParseStats* stats = nullptr);
+
+		/// Parses a null terminated URDF document in place. Attribute values are
+		/// read straight from the buffer instead of being copied, which overwrites
+		/// their closing quotes, so the buffer contents are garbage afterwards.
+		static std::shared_ptr<UrdfModel> fromUrdfBufferInSitu(char* xml_buffer,
+		                                                       const ParseOptions& options = ParseOptions(),
+		                                                       ParseStats* stats = nullptr);
+
+		/// Like the fromUrdf*() functions, but a broken document is not an
+		/// exception: the result holds the first ParseError instead, with its
+		/// code, element path and location. The message is only formatted when
+		/// asked for, and is the same the fromUrdf*() functions would throw.
+		static ParseResult<std::shared_ptr<UrdfModel>> tryFromUrdfStr(const std::string& xml_string,
+		                                                              const ParseOptions& options = ParseOptions());
+		static ParseResult<std::shared_ptr<UrdfModel>> tryFromUrdfFile(const std::string& path,
+		                                                               const ParseOptions& options = ParseOptions());
+		static ParseResult<std::shared_ptr<UrdfModel>> tryFromUrdfBufferInSitu(char* xml_buffer,
+		                                                                       const ParseOptions& options = ParseOptions());
+
+		/// Checks a URDF document with the same parsers, but goes on after an
+		/// error and returns every ParseError found, in document order with the
+		/// ones about the whole model last. Empty if the document is valid. An
+		/// element that is broken is left out of the model, which keeps the
+		/// errors it would cause further on from being reported as well.
+		static std::vector<ParseError> validateUrdfStr(const std::string& xml_string,
+		                                               const ParseOptions& options = ParseOptions());
+		static std::vector<ParseError> validateUrdfFile(const std::string& path,
+		                                                const ParseOptions& options = ParseOptions());
+		static std::vector<ParseError> validateUrdfBufferInSitu(char* xml_buffer,
+		                                                        const ParseOptions& options = ParseOptions());
+
+		/// Hash of a URDF document, stored in the binary form of the model parsed
+		/// from it so a cache can tell whether the document changed since.
+		static uint64_t contentHash(const char* data, size_t size);
+
+		/// Serializes the model into the versioned, little endian .urdfbin format.
+		/// source_hash is stored in the header, see contentHash().
+		std::string toBinary(uint64_t source_hash = 0) const;
+
+		/// Rebuilds a model from the output of toBinary(). The origin matrices are
+		/// cached again if they were cached in the serialized model. Throws
+		/// URDFParseError if the data has another format version, is truncated or
+		/// is corrupted.
+		static std::shared_ptr<UrdfModel> fromBinary(const char* data, size_t size);
+
+		/// Maps a .urdfbin file into memory and loads it with fromBinary().
+		static std::shared_ptr<UrdfModel> fromBinaryFile(const std::string& path);
+
+		/// Reads the source hash from the header of binary data without loading
+		/// the model. Returns false if the data is not a binary model of the
+		/// current format version.
+		static bool binarySourceHash(const char* data, size_t size, uint64_t& source_hash);
 	};
 
 }
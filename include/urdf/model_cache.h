@@ -0,0 +1,90 @@
+#ifndef URDF_MODEL_CACHE_H
+#define URDF_MODEL_CACHE_H
+
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "urdf/frozen_model.h"
+#include "urdf/model.h"
+
+namespace urdf {
+
+	/// Thread safe cache of parsed models, keyed by the content of the document.
+	///
+	/// A document is looked up by its UrdfModel::contentHash() and its size, and
+	/// a hit is confirmed by comparing the document with the copy kept in the
+	/// entry, so parsing the same text again returns the model that is already
+	/// loaded without touching the parser. The models are shared between all
+	/// callers, which is why they are handed out as FrozenModel.
+	///
+	/// Every entry is charged the size of its document copy, and once parsed the
+	/// FrozenModel::memoryUsage() estimate of its model. Once the entries exceed
+	/// the byte budget, the least recently used ones are dropped; models that are
+	/// still in use stay alive through their shared_ptr. If several threads ask
+	/// for the same document while it is being parsed, it is parsed only once.
+	class ModelCache {
+		public:
+			struct Statistics {
+				size_t hits;
+				size_t misses;
+				size_t evictions;
+				size_t entries;
+				size_t bytes;
+			};
+
+			explicit ModelCache(size_t byte_budget, const ParseOptions& options = ParseOptions());
+
+			/// Returns the cached model for the document, parsing, freezing and
+			/// adding it first on a miss. Parse errors are thrown and not cached.
+			std::shared_ptr<const FrozenModel> fromUrdfStr(const std::string& xml_string);
+			std::shared_ptr<const FrozenModel> fromUrdfBuffer(const char* xml_buffer, size_t size);
+
+			Statistics statistics() const;
+			size_t byteBudget() const { return byte_budget; }
+
+			void clear();
+
+		private:
+			ModelCache(const ModelCache&) = delete;
+			ModelCache& operator=(const ModelCache&) = delete;
+
+			struct Key {
+				uint64_t hash;
+				size_t size;
+				bool operator==(const Key& other) const { return hash == other.hash && size == other.size; }
+			};
+			struct KeyHash {
+				size_t operator()(const Key& key) const { return static_cast<size_t>(key.hash); }
+			};
+			struct Entry {
+				Key key;
+				size_t id;
+				std::string document;
+				std::shared_future<std::shared_ptr<const FrozenModel>> model;
+				size_t charge;  // bytes counted against the budget
+			};
+
+			void evict();
+
+			const size_t byte_budget;
+			const ParseOptions options;
+
+			mutable std::mutex mutex;
+			// most recently used first
+			std::list<Entry> entries;
+			std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+			size_t bytes;
+			size_t next_id;
+			size_t hits;
+			size_t misses;
+			size_t evictions;
+	};
+
+}
+
+#endif
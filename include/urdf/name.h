@@ -0,0 +1,137 @@
+#ifndef URDF_NAME_H
+#define URDF_NAME_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace urdf {
+
+	/// Interned, immutable string used for the names of links, joints and
+	/// materials.
+	///
+	/// Every distinct name is stored once in a process wide pool, and a Name is
+	/// only a pointer to that copy. Copying a Name copies the pointer, and two
+	/// Names are equal exactly if they point at the same entry, so comparing
+	/// them for equality or hashing them never looks at the characters. Names
+	/// are ordered by their text, so maps keyed by Name iterate in the same
+	/// order in every process.
+	///
+	/// The pool is thread safe. Its entries are reference counted by the Names
+	/// pointing at them, a name is dropped from the pool together with the last
+	/// model using it. Looking up a map entry by a plain string does not add to
+	/// the pool, see UrdfModel::link_map.
+	class Name {
+		public:
+			Name() : entry(&emptyEntry()) {}
+			Name(std::string_view text) : entry(intern(text)) {}
+			Name(const std::string& text) : Name(std::string_view(text)) {}
+			Name(const char* text) : Name(std::string_view(text)) {}
+
+			Name(const Name& other) : entry(other.entry) { acquire(entry); }
+			Name(Name&& other) noexcept : entry(other.entry) { other.entry = &emptyEntry(); }
+			~Name() { release(entry); }
+
+			Name& operator=(const Name& other) {
+				acquire(other.entry);
+				release(entry);
+				entry = other.entry;
+				return *this;
+			}
+			Name& operator=(Name&& other) noexcept {
+				std::swap(entry, other.entry);
+				return *this;
+			}
+
+			const std::string& str() const { return entry->text; }
+			operator const std::string&() const { return entry->text; }
+			operator std::string_view() const { return entry->text; }
+
+			const char* c_str() const { return entry->text.c_str(); }
+			size_t size() const { return entry->text.size(); }
+			bool empty() const { return entry->text.empty(); }
+			void clear() {
+				release(entry);
+				entry = &emptyEntry();
+			}
+
+			/// Identity of the interned string, equal for equal names.
+			const void* id() const { return entry; }
+
+			friend bool operator==(const Name& a, const Name& b) { return a.entry == b.entry; }
+			friend bool operator!=(const Name& a, const Name& b) { return a.entry != b.entry; }
+			friend bool operator<(const Name& a, const Name& b) { return a.entry != b.entry && a.entry->text < b.entry->text; }
+
+			// comparisons with text that is not interned, without interning it
+			friend bool operator==(const Name& a, std::string_view b) { return a.entry->text == b; }
+			friend bool operator==(std::string_view a, const Name& b) { return a == b.entry->text; }
+			friend bool operator!=(const Name& a, std::string_view b) { return a.entry->text != b; }
+			friend bool operator!=(std::string_view a, const Name& b) { return a != b.entry->text; }
+			friend bool operator<(const Name& a, std::string_view b) { return std::string_view(a.entry->text) < b; }
+			friend bool operator<(std::string_view a, const Name& b) { return a < std::string_view(b.entry->text); }
+
+			friend bool operator==(const Name& a, const std::string& b) { return a.entry->text == b; }
+			friend bool operator==(const std::string& a, const Name& b) { return a == b.entry->text; }
+			friend bool operator!=(const Name& a, const std::string& b) { return a.entry->text != b; }
+			friend bool operator!=(const std::string& a, const Name& b) { return a != b.entry->text; }
+			friend bool operator<(const Name& a, const std::string& b) { return a.entry->text < b; }
+			friend bool operator<(const std::string& a, const Name& b) { return a < b.entry->text; }
+
+			friend bool operator==(const Name& a, const char* b) { return a.entry->text == b; }
+			friend bool operator==(const char* a, const Name& b) { return a == b.entry->text; }
+			friend bool operator!=(const Name& a, const char* b) { return a.entry->text != b; }
+			friend bool operator!=(const char* a, const Name& b) { return a != b.entry->text; }
+			friend bool operator<(const Name& a, const char* b) { return a.entry->text < b; }
+			friend bool operator<(const char* a, const Name& b) { return a < b.entry->text; }
+
+			friend std::string operator+(const std::string& a, const Name& b) { return a + b.entry->text; }
+			friend std::string operator+(const Name& a, const std::string& b) { return a.entry->text + b; }
+			friend std::string operator+(const char* a, const Name& b) { return a + b.entry->text; }
+			friend std::string operator+(const Name& a, const char* b) { return a.entry->text + b; }
+
+			friend std::ostream& operator<<(std::ostream& out, const Name& name) { return out << name.entry->text; }
+
+			/// Number of distinct names in the pool.
+			static size_t poolSize();
+
+		private:
+			friend class NamePool;
+
+			/// A name in the pool and the number of Names pointing at it. The
+			/// empty name is not in the pool and not counted.
+			struct Entry {
+				explicit Entry(std::string_view text) : text(text), references(1) {}
+
+				const std::string text;
+				std::atomic<size_t> references;
+			};
+
+			static Entry& emptyEntry();
+			static Entry* intern(std::string_view text);
+			static void release(Entry* entry);
+
+			static void acquire(Entry* entry) {
+				if (!entry->text.empty()) {
+					entry->references.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+
+			Entry* entry;
+	};
+
+}
+
+namespace std {
+	template<>
+	struct hash<urdf::Name> {
+		size_t operator()(const urdf::Name& name) const noexcept {
+			return std::hash<const void*>()(name.id());
+		}
+	};
+}
+
+#endif
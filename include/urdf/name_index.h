@@ -0,0 +1,45 @@
+#ifndef URDF_NAME_INDEX_H
+#define URDF_NAME_INDEX_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace urdf {
+
+	/// Immutable hash table from names to their position in a list, built once.
+	///
+	/// Open addressing with linear probing in a power of two table that is at
+	/// most half full. Each slot keeps 32 bits of the name's hash next to the
+	/// index, so a probe only compares strings when the hashes match, and a
+	/// lookup usually touches a single cache line plus the name itself.
+	class NameIndex {
+		public:
+			NameIndex() : mask(0) {}
+			/// names[i] is found at index i. Of duplicate names the first one wins.
+			explicit NameIndex(const std::vector<std::string>& names);
+
+			/// Index of the name, or -1 if it is not in the table.
+			int find(std::string_view name) const;
+
+			size_t size() const { return names.size(); }
+			const std::string& name(size_t index) const { return names[index]; }
+
+			/// Heap memory held by the table and its copy of the names.
+			size_t memoryUsage() const;
+
+		private:
+			struct Slot {
+				uint32_t hash;
+				int32_t index;  // -1 for an empty slot
+			};
+
+			std::vector<std::string> names;
+			std::vector<Slot> slots;
+			size_t mask;
+	};
+
+}
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef URDF_PARSE_ERROR_H
+#define URDF_PARSE_ERROR_H
+
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "urdf/exception.h"
+
+class TiXmlElement;
+
+namespace urdf {
+
+	enum class ParseErrorCode {
+		NONE,
+		FILE_ERROR,          // the file could not be read
+		XML_SYNTAX,          // the document is not well formed XML
+		MISSING_ELEMENT,     // a required element is missing
+		MISSING_ATTRIBUTE,   // a required attribute is missing
+		INVALID_NUMBER,      // an attribute is not a number, or not the right count of numbers
+		INVALID_VALUE,       // an attribute has a value that is not allowed, e.g. an unknown joint type
+		DUPLICATE_NAME,      // two materials, links or joints have the same name
+		UNDEFINED_MATERIAL,  // a visual uses a material that is defined nowhere
+		UNKNOWN_LINK,        // a joint connects a link that does not exist
+		INVALID_TREE         // the links do not form a single tree
+	};
+
+	/// Description of a problem in a URDF document.
+	///
+	/// Only the parts of the message are stored when the error is found, the
+	/// text itself is put together by message() when someone asks for it. So
+	/// rejecting a document costs a few small copies instead of formatting and
+	/// throwing an exception.
+	class ParseError {
+		public:
+			ParseError() : error_code(ParseErrorCode::NONE), format(""), offset(-1), line_number(-1), column_number(-1) {}
+
+			/// format is a string literal, every "{}" in it is replaced by the next
+			/// argument and "{cause}" by the message of the cause.
+			ParseError(ParseErrorCode code, const char* format, std::initializer_list<std::string_view> args = {});
+
+			ParseErrorCode code() const { return error_code; }
+			std::string message() const;
+
+			/// Path of the element the error is about, like
+			/// /robot/link[@name='base']/visual/geometry/box. Empty if unknown.
+			const std::string& elementPath() const { return element_path; }
+			/// Byte offset of the element in the document, and its 1 based line and
+			/// column, -1 if unknown.
+			int byteOffset() const { return offset; }
+			int line() const { return line_number; }
+			int column() const { return column_number; }
+
+			/// An error about a part of an element, like a single value, whose
+			/// message is embedded in this one.
+			const ParseError* cause() const { return error_cause.get(); }
+
+			void setCause(ParseError cause);
+			void setElement(const TiXmlElement* element);
+			/// For errors about the model rather than a single element.
+			void setElementPath(std::string path) { element_path = std::move(path); }
+			void setLocation(int offset, int line, int column);
+
+			/// URDFParseError with the same message and location.
+			URDFParseError exception() const;
+
+		private:
+			ParseErrorCode error_code;
+			const char* format;
+			std::vector<std::string> args;
+			std::shared_ptr<const ParseError> error_cause;
+			std::string element_path;
+			int offset;
+			int line_number;
+			int column_number;
+	};
+
+	/// Where the parsers report the errors they find.
+	///
+	/// THROW throws every error as an URDFParseError right away, which is how the
+	/// fromXml() and fromUrdf*() functions behave. FIRST keeps only the first
+	/// error, which is what the tryFromUrdf*() functions use. ALL keeps every
+	/// error and lets the parsers go on with the rest of the document, for
+	/// the validateUrdf*() functions.
+	///
+	/// A parser that reports an error still looks at the rest of its element,
+	/// but returns nullptr (or false) in the end. count() tells whether anything
+	/// was reported in between.
+	class ParseErrors {
+		public:
+			enum Mode {
+				THROW,
+				FIRST,
+				ALL
+			};
+
+			explicit ParseErrors(Mode mode) : mode(mode), reported(0) {}
+
+			void report(const TiXmlElement* element, ParseErrorCode code, const char* format,
+			            std::initializer_list<std::string_view> args = {});
+			/// cause is embedded where the format has "{cause}".
+			void report(const TiXmlElement* element, ParseErrorCode code, const char* format,
+			            std::initializer_list<std::string_view> args, ParseError cause);
+			/// Reports a finished error, element is only used if it has no path yet.
+			void report(const TiXmlElement* element, ParseError error);
+
+			/// Number of errors reported so far, kept or not.
+			size_t count() const { return reported; }
+			bool failed() const { return reported > 0; }
+			/// Whether there is no point in looking at more of the document.
+			bool stop() const { return mode != ALL && reported > 0; }
+			Mode getMode() const { return mode; }
+			const std::vector<ParseError>& getErrors() const { return errors; }
+			std::vector<ParseError>& getErrors() { return errors; }
+
+		private:
+			Mode mode;
+			size_t reported;
+			std::vector<ParseError> errors;
+	};
+
+	/// Either a value or the ParseError that kept it from being made, like
+	/// std::expected.
+	template<typename T>
+	class ParseResult {
+		public:
+			ParseResult(T value) : result(std::in_place_index<0>, std::move(value)) {}
+			ParseResult(ParseError error) : result(std::in_place_index<1>, std::move(error)) {}
+
+			bool ok() const { return result.index() == 0; }
+			explicit operator bool() const { return ok(); }
+
+			/// Throws the error as URDFParseError if there is no value.
+			T& value() {
+				if (!ok()) {
+					throw error().exception();
+				}
+				return std::get<0>(result);
+			}
+			const T& value() const {
+				if (!ok()) {
+					throw error().exception();
+				}
+				return std::get<0>(result);
+			}
+
+			/// Only valid if there is no value.
+			const ParseError& error() const { return std::get<1>(result); }
+
+		private:
+			std::variant<T, ParseError> result;
+	};
+
+}
+
+#endif
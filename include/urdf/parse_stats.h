@@ -0,0 +1,53 @@
+#ifndef URDF_PARSE_STATS_H
+#define URDF_PARSE_STATS_H
+
+#include <cstddef>
+
+namespace urdf {
+
+	/// Where the time of a parse went, filled by the fromUrdf*() functions when
+	/// they are handed one. Only collected if the library is built with
+	/// URDF_PARSE_STATS, otherwise the fields stay zero and the collection is
+	/// not compiled in at all.
+	struct ParseStats {
+		/// Wall time of each phase in seconds. Number parsing is part of the
+		/// conversion of the element the number belongs to.
+		double xml_seconds;                  // TinyXML building the DOM, or reading the document when streaming
+		double material_seconds;             // converting and adding the <material> elements
+		double link_seconds;                 // converting the <link> elements, and the <joint> ones if num_threads > 1
+		double material_resolution_seconds;  // adding the links, which looks up the materials of their visuals
+		double joint_seconds;                // converting and adding the <joint> elements
+		double link_tree_seconds;            // initLinkTree() and findRoot()
+		double origin_matrix_seconds;        // cacheOriginMatrices(), if asked for
+		double total_seconds;
+
+		size_t bytes;        // length of the document
+		size_t elements;     // XML elements in the document
+		size_t attributes;   // XML attributes in the document
+		/// Heap blocks taken by the DOM: the arena blocks, or one per element and
+		/// attribute when streaming.
+		size_t allocations;
+
+		size_t materials;
+		size_t links;
+		size_t joints;
+
+#ifdef URDF_PARSE_STATS
+		static constexpr bool enabled = true;
+#else
+		static constexpr bool enabled = false;
+#endif
+
+		void clear() {
+			xml_seconds = material_seconds = link_seconds = material_resolution_seconds = 0.;
+			joint_seconds = link_tree_seconds = origin_matrix_seconds = total_seconds = 0.;
+			bytes = elements = attributes = allocations = 0;
+			materials = links = joints = 0;
+		}
+
+		ParseStats() { clear(); }
+	};
+
+}
+
+#endif
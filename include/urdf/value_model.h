@@ -0,0 +1,105 @@
+#ifndef URDF_VALUE_MODEL_H
+#define URDF_VALUE_MODEL_H
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "urdf/common.h"
+#include "urdf/geometry.h"
+#include "urdf/joint.h"
+#include "urdf/link.h"
+#include "urdf/name.h"
+#include "urdf/name_index.h"
+
+namespace urdf {
+
+	struct CompiledModel;
+	struct UrdfModel;
+
+	/// Geometry held by value, std::visit it or check index() against
+	/// GeometryType, which lists the shapes in the same order.
+	typedef std::variant<Sphere, Box, Cylinder, Capsule, Mesh> GeometryValue;
+
+	struct VisualValue {
+		std::string name;
+		Transform origin;
+		std::optional<GeometryValue> geometry;
+		int material;  // index into ValueModel::materials, -1 if the visual has none
+	};
+
+	struct CollisionValue {
+		std::string name;
+		Transform origin;
+		std::optional<GeometryValue> geometry;
+	};
+
+	struct LinkValue {
+		Name name;
+		std::optional<Inertial> inertial;
+		std::vector<VisualValue> visuals;
+		std::vector<CollisionValue> collisions;
+
+		int parent_link;   // -1 for the root link
+		int parent_joint;  // -1 for the root link
+		std::vector<int> child_links;
+	};
+
+	struct JointValue {
+		Name name;
+		JointType type;
+		Vector3 axis;
+		Transform parent_to_joint_transform;
+		int parent_link;
+		int child_link;
+
+		std::optional<JointDynamics> dynamics;
+		std::optional<JointLimits> limits;
+		std::optional<JointSafety> safety;
+		std::optional<JointCalibration> calibration;
+		std::optional<JointMimic> mimic;
+	};
+
+	/// Value semantic form of a UrdfModel.
+	///
+	/// Links hold their visuals and collisions, and joints their properties,
+	/// directly instead of through a shared_ptr each, and geometries are a
+	/// variant instead of a Geometry subclass on the heap. A model is a handful
+	/// of vectors, so walking every collision shape reads contiguous memory, and
+	/// copying a ValueModel copies everything, no state is shared between copies.
+	///
+	/// Links and joints are numbered like in the CompiledModel: links in
+	/// topological order with the root at 0, joint j moving link j + 1.
+	struct ValueModel {
+		Name name;
+		std::vector<Material> materials;
+		std::vector<LinkValue> links;
+		std::vector<JointValue> joints;
+
+		/// Index of the named element, or -1 if there is none.
+		int linkIndex(std::string_view name) const { return link_names.find(name); }
+		int jointIndex(std::string_view name) const { return joint_names.find(name); }
+		int materialIndex(std::string_view name) const { return material_names.find(name); }
+
+		/// Converts a model with a valid link tree, in the order of
+		/// CompiledModel::fromUrdfModel. The model is only read.
+		static ValueModel fromUrdfModel(const UrdfModel& model);
+		/// The same for a model that was compiled already.
+		static ValueModel fromUrdfModel(const UrdfModel& model, const CompiledModel& compiled);
+
+		/// Estimate of the heap memory held by the model, from the capacity of
+		/// its vectors and strings. Interned names are shared and not counted.
+		size_t memoryUsage() const;
+
+		private:
+			NameIndex link_names;
+			NameIndex joint_names;
+			NameIndex material_names;
+	};
+
+}
+
+#endif
@@ -0,0 +1,73 @@
+// Replaces the global operator new so AllocationTracker sees every heap
+// allocation of the program. Built as the urdfparser_allocation_hook object
+// library and only linked into programs that ask for it, the array and
+// nothrow forms of operator new fall back to these ones.
+//
+// Every block carries a header with its size and whether it was counted, so
+// freeing it releases exactly what was recorded for it.
+
+#include "urdf/allocations.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace {
+	struct Header {
+		void* block;    // as returned by malloc
+		std::size_t size;
+		bool counted;   // passed to release() when freed
+	};
+
+	void* allocate(std::size_t size, std::size_t alignment) {
+		if (alignment < alignof(std::max_align_t)) {
+			alignment = alignof(std::max_align_t);
+		}
+		char* block = static_cast<char*>(std::malloc(size + sizeof(Header) + alignment - 1));
+		if (block == nullptr) {
+			throw std::bad_alloc();
+		}
+		std::uintptr_t first = reinterpret_cast<std::uintptr_t>(block) + sizeof(Header);
+		char* p = reinterpret_cast<char*>((first + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1));
+		Header* header = reinterpret_cast<Header*>(p) - 1;
+		header->block = block;
+		header->size = size;
+		header->counted = urdf::AllocationTracker::record(size);
+		return p;
+	}
+
+	void deallocate(void* p) {
+		if (p != nullptr) {
+			Header* header = static_cast<Header*>(p) - 1;
+			if (header->counted) {
+				urdf::AllocationTracker::release(header->size);
+			}
+			std::free(header->block);
+		}
+	}
+}
+
+void* operator new(std::size_t size) {
+	return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+	return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept {
+	deallocate(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+	deallocate(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+	deallocate(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+	deallocate(p);
+}
@@ -0,0 +1,97 @@
+#include "urdf/allocations.h"
+
+#include <atomic>
+#include <new>
+
+using namespace urdf;
+
+thread_local AllocationSubsystem AllocationScope::current = AllocationSubsystem::OTHER;
+
+namespace {
+	struct Counters {
+		std::atomic<size_t> allocations;
+		std::atomic<size_t> bytes;
+	};
+
+	// only counted while a tracker is alive, the hook costs one load otherwise
+	Counters counters[NUM_ALLOCATION_SUBSYSTEMS];
+	// the counted blocks that are not freed yet
+	std::atomic<long> live_blocks(0);
+	std::atomic<long> live_bytes(0);
+	std::atomic<long> peak_live_bytes(0);
+	std::atomic<int> num_trackers(0);
+	std::atomic<bool> hook_called(false);
+
+	AllocationReport currentCounts() {
+		AllocationReport report;
+		for (size_t i = 0; i < NUM_ALLOCATION_SUBSYSTEMS; i++) {
+			report.subsystems[i].allocations = counters[i].allocations.load();
+			report.subsystems[i].bytes = counters[i].bytes.load();
+		}
+		report.live_blocks = live_blocks.load();
+		report.live_bytes = live_bytes.load();
+		report.peak_live_bytes = peak_live_bytes.load();
+		return report;
+	}
+}
+
+AllocationCounts AllocationReport::total() const {
+	AllocationCounts sum = { 0, 0 };
+	for (const AllocationCounts& counts : subsystems) {
+		sum.allocations += counts.allocations;
+		sum.bytes += counts.bytes;
+	}
+	return sum;
+}
+
+AllocationTracker::AllocationTracker() {
+	num_trackers++;
+	peak_live_bytes.store(live_bytes.load());
+	start = currentCounts();
+}
+
+AllocationTracker::~AllocationTracker() {
+	num_trackers--;
+}
+
+AllocationReport AllocationTracker::report() const {
+	AllocationReport report = currentCounts();
+	for (size_t i = 0; i < NUM_ALLOCATION_SUBSYSTEMS; i++) {
+		report.subsystems[i].allocations -= start.subsystems[i].allocations;
+		report.subsystems[i].bytes -= start.subsystems[i].bytes;
+	}
+	report.live_blocks -= start.live_blocks;
+	report.live_bytes -= start.live_bytes;
+	report.peak_live_bytes -= start.live_bytes;
+	return report;
+}
+
+bool AllocationTracker::hooked() {
+	// a call rather than a new expression, which the compiler may leave out
+	::operator delete(::operator new(1));
+	return hook_called.load(std::memory_order_relaxed);
+}
+
+bool AllocationTracker::record(size_t bytes) {
+	if (!hook_called.load(std::memory_order_relaxed)) {
+		hook_called.store(true, std::memory_order_relaxed);
+	}
+	if (num_trackers.load(std::memory_order_relaxed) == 0) {
+		return false;
+	}
+	Counters& subsystem = counters[static_cast<size_t>(AllocationScope::current)];
+	subsystem.allocations.fetch_add(1, std::memory_order_relaxed);
+	subsystem.bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+	live_blocks.fetch_add(1, std::memory_order_relaxed);
+	long live = live_bytes.fetch_add(static_cast<long>(bytes), std::memory_order_relaxed) + static_cast<long>(bytes);
+	long peak = peak_live_bytes.load(std::memory_order_relaxed);
+	while (live > peak && !peak_live_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+	return true;
+}
+
+void AllocationTracker::release(size_t bytes) {
+	// also once the tracker that counted the block is gone
+	live_blocks.fetch_sub(1, std::memory_order_relaxed);
+	live_bytes.fetch_sub(static_cast<long>(bytes), std::memory_order_relaxed);
+}
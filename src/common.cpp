@@ -1,42 +1,108 @@
 #include "urdf/common.h"
-#include <boost/algorithm/string.hpp>
-#include <boost/lexical_cast.hpp>
+#include <charconv>
 
 using namespace urdf;
 using namespace std;
 
-// ------------------- Vector Implementation -------------------
+// ------------------- Number Parsing Implementation -------------------
 
-Vector3 Vector3::fromVecStr(const string& vector_str) {
-	Vector3 vec;
-
-	vector<string> pieces;
-	vector<double> values;
-
-	boost::split( pieces, vector_str, boost::is_any_of(" "));
-	for (unsigned int i = 0; i < pieces.size(); ++i){
-		if (pieces[i] != ""){
-			try {
-				values.push_back(boost::lexical_cast<double>(pieces[i].c_str()));
-			} catch (boost::bad_lexical_cast &e) {
-				throw URDFParseError("Error not able to parse component (" + pieces[i] + ") to a double (while parsing a vector value)");
+static inline bool isNumberSeparator(char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Parses the token [begin, end) as a double. The whole token has to be consumed,
+// so trailing garbage like "1.0abc" is rejected just as boost::lexical_cast did.
+static bool parseToken(const char* begin, const char* end, double& value) {
+	// std::from_chars does not accept an explicit plus sign
+	if (begin != end && *begin == '+') {
+		++begin;
+		if (begin != end && *begin == '-') {
+			return false;
+		}
+	}
+
+	auto result = std::from_chars(begin, end, value);
+	return result.ec == std::errc() && result.ptr == end;
+}
+
+size_t urdf::parseDoubles(const char* str, double* values, size_t max_values, string_view* bad_token) {
+	size_t count = 0;
+	if (bad_token != nullptr) {
+		*bad_token = string_view();
+	}
+
+	const char* p = str;
+	while (*p != '\0') {
+		while (isNumberSeparator(*p)) {
+			++p;
+		}
+		if (*p == '\0') {
+			break;
+		}
+
+		const char* token_end = p;
+		while (*token_end != '\0' && !isNumberSeparator(*token_end)) {
+			++token_end;
+		}
+
+		double value;
+		if (!parseToken(p, token_end, value)) {
+			if (bad_token != nullptr) {
+				*bad_token = string_view(p, token_end - p);
 			}
+			return count;
+		}
+		if (count < max_values) {
+			values[count] = value;
 		}
+		++count;
+		p = token_end;
 	}
 
-	if (values.size() != 3) {
-		ostringstream error_msg;
-		error_msg << "Parser found " << values.size()
-				  << " elements but 3 expected while parsing vector ["
-				  << vector_str <<  "]";
-		throw URDFParseError(error_msg.str());
+	return count;
+}
+
+bool urdf::parseDouble(const char* str, double& value) {
+	string_view bad_token;
+	return parseDoubles(str, &value, 1, &bad_token) == 1 && bad_token.empty();
+}
+
+// ------------------- Vector Implementation -------------------
+
+bool Vector3::fromVecStr(const char* vector_str, Vector3& vector, ParseError& error) {
+	double values[3];
+	string_view bad_token;
+
+	size_t count = parseDoubles(vector_str, values, 3, &bad_token);
+	if (!bad_token.empty()) {
+		error = ParseError(ParseErrorCode::INVALID_NUMBER,
+		                   "Error not able to parse component ({}) to a double (while parsing a vector value)",
+		                   { bad_token });
+		return false;
+	}
+
+	if (count != 3) {
+		error = ParseError(ParseErrorCode::INVALID_NUMBER,
+		                   "Parser found {} elements but 3 expected while parsing vector [{}]",
+		                   { to_string(count), vector_str });
+		return false;
 	}
 
-	vec.x = values[0];
-	vec.y = values[1];
-	vec.z = values[2];
+	vector = Vector3(values[0], values[1], values[2]);
+	return true;
+}
 
-	return vec;
+Vector3 Vector3::fromVecStr(const char* vector_str) {
+	Vector3 vector;
+	ParseError error;
+	if (!fromVecStr(vector_str, vector, error)) {
+		throw error.exception();
+	}
+	return vector;
+}
+
+Vector3 Vector3::fromVecStr(const string& vector_str) {
+	return fromVecStr(vector_str.c_str());
 }
 
 Vector3 Vector3::operator+(const Vector3& other) {
@@ -110,21 +176,21 @@ Rotation Rotation::operator*( const Rotation &other ) const {
 }
 
 Vector3 Rotation::operator*(const Vector3& vec) const {
-	Rotation t;
-	Vector3 result;
-
-	t.w = 0.0;
-	t.x = vec.x;
-	t.y = vec.y;
-	t.z = vec.z;
-
-	t = (*this) * (t * getInverse());
+	// q v q^-1 expanded, divided by the squared norm for quaternions that are
+	// not normalized
+	double norm = w*w + x*x + y*y + z*z;
+	if (norm == 0.0) {
+		return Vector3(0., 0., 0.);
+	}
 
-	result.x = t.x;
-	result.y = t.y;
-	result.z = t.z;
+	double dot = x*vec.x + y*vec.y + z*vec.z;
+	double a = (w*w - (x*x + y*y + z*z)) / norm;
+	double b = 2.0 * dot / norm;
+	double c = 2.0 * w / norm;
 
-	return result;
+	return Vector3(a*vec.x + b*x + c*(y*vec.z - z*vec.y),
+	               a*vec.y + b*y + c*(z*vec.x - x*vec.z),
+	               a*vec.z + b*z + c*(x*vec.y - y*vec.x));
 }
 
 
@@ -147,56 +213,188 @@ Rotation Rotation::fromRpy(double roll, double pitch, double yaw) {
 };
 
 
-Rotation Rotation::fromRpyStr(const string &rotation_str) {
+Rotation Rotation::fromRpyStr(const char* rotation_str) {
 	Vector3 rpy = Vector3::fromVecStr(rotation_str);
 	return Rotation::fromRpy(rpy.x, rpy.y, rpy.z);
 }
 
+Rotation Rotation::fromRpyStr(const string &rotation_str) {
+	return fromRpyStr(rotation_str.c_str());
+}
+
+bool Rotation::fromRpyStr(const char* rotation_str, Rotation& rotation, ParseError& error) {
+	Vector3 rpy;
+	if (!Vector3::fromVecStr(rotation_str, rpy, error)) {
+		return false;
+	}
+	rotation = Rotation::fromRpy(rpy.x, rpy.y, rpy.z);
+	return true;
+}
+
 // ------------------- Color Implementation -------------------
 
+bool Color::fromColorStr(const char* vector_str, Color& color, ParseError& error) {
+	double values[4];
+	string_view bad_token;
+
+	size_t count = parseDoubles(vector_str, values, 4, &bad_token);
+	if (!bad_token.empty()) {
+		error = ParseError(ParseErrorCode::INVALID_NUMBER,
+		                   "Error parsing Color value {} in color value string ({}): value ({}) is not a double!",
+		                   { to_string(count), vector_str, bad_token });
+		return false;
+	}
+
+	if (count != 4) {
+		error = ParseError(ParseErrorCode::INVALID_NUMBER,
+		                   "Error parsing Color string ({}): It needs to contain exactly 4 values for rbdl color!",
+		                   { vector_str });
+		return false;
+	}
+
+	color = Color( values[0], values[1], values[2], values[3] );
+	return true;
+}
+
+Color Color::fromColorStr(const char* vector_str) {
+	Color color;
+	ParseError error;
+	if (!fromColorStr(vector_str, color, error)) {
+		throw error.exception();
+	}
+	return color;
+}
+
 Color Color::fromColorStr(const std::string &vector_str) {
-	std::vector<std::string> pieces;
-	std::vector<float> values;
-
-	boost::split(pieces, vector_str, boost::is_any_of(" "));
-	for (int i = 0; i < pieces.size(); i++) {
-		if (!pieces[i].empty()) {
-			try {
-				values.push_back(boost::lexical_cast<double>(pieces[i].c_str()));
-			} catch (boost::bad_lexical_cast &e) {
-				std::ostringstream error_msg;
-				error_msg << "Error parsing Color value " << i
-						  << " in color value string (" << vector_str
-						  << "): value is not a double: " << e.what() << "!";
-				throw URDFParseError(error_msg.str());
-			}
+	return fromColorStr(vector_str.c_str());
+}
+
+// ------------------- Transform Implementation -------------------
+
+Transform Transform::operator*(const Transform& other) const {
+	Vector3 moved = rotation * other.position;
+	return Transform(Vector3(position.x + moved.x, position.y + moved.y, position.z + moved.z),
+	                 rotation * other.rotation);
+}
+
+Vector3 Transform::operator*(const Vector3& point) const {
+	Vector3 moved = rotation * point;
+	return Vector3(position.x + moved.x, position.y + moved.y, position.z + moved.z);
+}
+
+Transform Transform::getInverse() const {
+	Rotation inverse = rotation.getInverse();
+	Vector3 moved = inverse * position;
+	return Transform(Vector3(-moved.x, -moved.y, -moved.z), inverse);
+}
+
+// ------------------- Matrix3x4 Implementation -------------------
+
+Matrix3x4 Matrix3x4::fromTransform(const Transform& transform) {
+	// scaled so that quaternions which are not normalized still give a rotation
+	const Rotation& q = transform.rotation;
+	double norm = q.w*q.w + q.x*q.x + q.y*q.y + q.z*q.z;
+	double s = norm > 0.0 ? 2.0 / norm : 0.0;
+	double xx = q.x*q.x*s, yy = q.y*q.y*s, zz = q.z*q.z*s;
+	double xy = q.x*q.y*s, xz = q.x*q.z*s, yz = q.y*q.z*s;
+	double wx = q.w*q.x*s, wy = q.w*q.y*s, wz = q.w*q.z*s;
+	double diagonal = norm > 0.0 ? 1.0 : 0.0;
+
+	Matrix3x4 result;
+	result.m[0] = diagonal - (yy + zz); result.m[1] = xy - wz;              result.m[2] = xz + wy;
+	result.m[4] = xy + wz;              result.m[5] = diagonal - (xx + zz); result.m[6] = yz - wx;
+	result.m[8] = xz - wy;              result.m[9] = yz + wx;              result.m[10] = diagonal - (xx + yy);
+	result.m[3] = transform.position.x;
+	result.m[7] = transform.position.y;
+	result.m[11] = transform.position.z;
+	return result;
+}
+
+Matrix3x4 Matrix3x4::operator*(const Matrix3x4& other) const {
+	Matrix3x4 result;
+	for (int row = 0; row < 3; row++) {
+		const double* r = m + 4 * row;
+		for (int col = 0; col < 4; col++) {
+			result.m[4 * row + col] = r[0] * other.m[col] + r[1] * other.m[4 + col] + r[2] * other.m[8 + col];
 		}
+		result.m[4 * row + 3] += r[3];
 	}
+	return result;
+}
+
+Vector3 Matrix3x4::operator*(const Vector3& point) const {
+	return Vector3(m[0]*point.x + m[1]*point.y + m[2]*point.z + m[3],
+	               m[4]*point.x + m[5]*point.y + m[6]*point.z + m[7],
+	               m[8]*point.x + m[9]*point.y + m[10]*point.z + m[11]);
+}
 
-	if (values.size() != 4) {
-		std::ostringstream error_msg;
-		error_msg << "Error parsing Color string (" << vector_str
-				  << "): It needs to contain exactly 4 values for rbdl color!";
-		throw URDFParseError(error_msg.str());
+// ------------------- Batch kernels -------------------
+
+namespace {
+	static_assert(sizeof(Vector3) == 3 * sizeof(double), "Vector3 arrays have to be packed doubles");
+
+	// Applies the 3x4 matrix m to count packed xyz triples. Reading all three
+	// inputs before writing keeps in place use correct.
+	inline void affineKernel(const double* m, const double* in, double* out, size_t count) {
+		const double m0 = m[0], m1 = m[1], m2 = m[2], ox = m[3];
+		const double m4 = m[4], m5 = m[5], m6 = m[6], oy = m[7];
+		const double m8 = m[8], m9 = m[9], m10 = m[10], oz = m[11];
+		for (size_t i = 0; i < count; i++) {
+			const double vx = in[3*i], vy = in[3*i + 1], vz = in[3*i + 2];
+			out[3*i]     = m0*vx + m1*vy + m2*vz + ox;
+			out[3*i + 1] = m4*vx + m5*vy + m6*vz + oy;
+			out[3*i + 2] = m8*vx + m9*vy + m10*vz + oz;
+		}
 	}
+}
 
-	return Color( values[0], values[1], values[2], values[3] );
+void urdf::rotateVectors(const Rotation& rotation, const Vector3* in, Vector3* out, size_t count) {
+	Matrix3x4 matrix = Matrix3x4::fromTransform(Transform(Vector3(), rotation));
+	affineKernel(matrix.m, &in->x, &out->x, count);
 }
 
-// ------------------- Transform Implementation -------------------
+void urdf::transformPoints(const Transform& transform, const Vector3* in, Vector3* out, size_t count) {
+	Matrix3x4 matrix = Matrix3x4::fromTransform(transform);
+	affineKernel(matrix.m, &in->x, &out->x, count);
+}
 
-Transform Transform::fromXml(TiXmlElement* xml) {
-	Transform t;
+void urdf::transformPoints(const Matrix3x4& transform, const Vector3* in, Vector3* out, size_t count) {
+	affineKernel(transform.m, &in->x, &out->x, count);
+}
+
+void urdf::composeTransforms(const Transform* a, const Transform* b, Transform* out, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		out[i] = a[i] * b[i];
+	}
+}
+
+void urdf::invertTransforms(const Transform* in, Transform* out, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		out[i] = in[i].getInverse();
+	}
+}
+
+bool Transform::fromXml(TiXmlElement* xml, Transform& transform, ParseError& error) {
+	transform.clear();
 	if (xml) {
 		const char* xyz_str = xml->Attribute("xyz");
-		if (xyz_str != NULL) {
-			t.position = Vector3::fromVecStr(xyz_str);
+		if (xyz_str != NULL && !Vector3::fromVecStr(xyz_str, transform.position, error)) {
+			return false;
 		}
 
 		const char* rpy_str = xml->Attribute("rpy");
-		if (rpy_str != NULL) {
-			t.rotation = Rotation::fromRpyStr(rpy_str);
+		if (rpy_str != NULL && !Rotation::fromRpyStr(rpy_str, transform.rotation, error)) {
+			return false;
 		}
 	}
+	return true;
+}
+
+Transform Transform::fromXml(TiXmlElement* xml) {
+	Transform t;
+	ParseError error;
+	if (!fromXml(xml, t, error)) {
+		throw error.exception();
+	}
 	return t;
 }
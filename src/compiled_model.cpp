@@ -0,0 +1,104 @@
+#include "urdf/compiled_model.h"
+#include "urdf/model.h"
+
+#include <sstream>
+#include <unordered_map>
+
+using namespace urdf;
+
+int CompiledModel::jointPositionCount(JointType type) {
+	switch (type) {
+		case JointType::REVOLUTE:
+		case JointType::CONTINUOUS:
+		case JointType::PRISMATIC:
+			return 1;
+		case JointType::PLANAR:
+			return 3;
+		case JointType::FLOATING:
+			return 7;
+		default:
+			return 0;
+	}
+}
+
+std::shared_ptr<CompiledModel> CompiledModel::fromUrdfModel(const UrdfModel& model) {
+	std::shared_ptr<CompiledModel> compiled = std::make_shared<CompiledModel>();
+
+	if (model.root_link == nullptr) {
+		throw URDFParseError("Error while compiling model! The model has no root link.");
+	}
+
+	size_t num_links = model.link_map.size();
+	compiled->links.reserve(num_links);
+	compiled->link_parent.reserve(num_links);
+	compiled->link_parent_joint.reserve(num_links);
+
+	// the model may be shared by other threads, so the indices are kept here
+	// instead of in Link::link_index, see UrdfModel::assignIndices()
+	std::unordered_map<const Link*, int> link_indices;
+	link_indices.reserve(num_links);
+
+	// depth first pre-order traversal, children are visited in the order of
+	// Link::child_links so the result is deterministic
+	std::vector<std::shared_ptr<Link>> stack;
+	stack.push_back(model.root_link);
+	while (!stack.empty()) {
+		std::shared_ptr<Link> link = stack.back();
+		stack.pop_back();
+
+		int index = static_cast<int>(compiled->links.size());
+		if (!link_indices.emplace(link.get(), index).second) {
+			ostringstream error_msg;
+			error_msg << "Error while compiling model! Link [" << link->name
+					  << "] is reached by more than one joint.";
+			throw URDFParseError(error_msg.str());
+		}
+
+		compiled->links.push_back(link);
+
+		if (index == 0) {
+			compiled->link_parent.push_back(-1);
+			compiled->link_parent_joint.push_back(-1);
+		} else {
+			std::shared_ptr<Joint> joint = link->parent_joint;
+			int parent = link_indices.at(link->getParent().get());
+
+			compiled->link_parent.push_back(parent);
+			compiled->link_parent_joint.push_back(index - 1);
+
+			compiled->joints.push_back(joint);
+			compiled->joint_parent_link.push_back(parent);
+			compiled->joint_child_link.push_back(index);
+			compiled->joint_type.push_back(joint->type);
+			compiled->joint_axis.push_back(joint->axis);
+			compiled->joint_origin.push_back(joint->parent_to_joint_transform);
+			compiled->joint_position_index.push_back(static_cast<int>(compiled->num_positions));
+			compiled->num_positions += jointPositionCount(joint->type);
+		}
+
+		for (auto child = link->child_links.rbegin(); child != link->child_links.rend(); child++) {
+			stack.push_back(*child);
+		}
+	}
+
+	if (compiled->links.size() != num_links) {
+		ostringstream error_msg;
+		error_msg << "Error while compiling model! Only " << compiled->links.size()
+				  << " of " << num_links << " links are connected to the root link ["
+				  << model.root_link->name << "].";
+		throw URDFParseError(error_msg.str());
+	}
+
+	return compiled;
+}
+
+std::shared_ptr<CompiledModel> UrdfModel::assignIndices() {
+	std::shared_ptr<CompiledModel> compiled = CompiledModel::fromUrdfModel(*this);
+	for (size_t i = 0; i < compiled->numLinks(); i++) {
+		compiled->links[i]->link_index = static_cast<int>(i);
+	}
+	for (size_t j = 0; j < compiled->numJoints(); j++) {
+		compiled->joints[j]->joint_index = static_cast<int>(j);
+	}
+	return compiled;
+}
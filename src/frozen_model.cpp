@@ -0,0 +1,62 @@
+#include "urdf/frozen_model.h"
+
+#include "memory_usage.h"
+
+using namespace urdf;
+
+std::shared_ptr<const FrozenModel> UrdfModel::freeze() const {
+	return std::shared_ptr<const FrozenModel>(new FrozenModel(*this));
+}
+
+FrozenModel::FrozenModel(const UrdfModel& model) {
+	// the model is only read, its links and joints are not kept
+	std::shared_ptr<CompiledModel> tree = CompiledModel::fromUrdfModel(model);
+	values = ValueModel::fromUrdfModel(model, *tree);
+	materials = std::make_shared<const std::vector<Material>>(std::move(values.materials));
+	values.materials.clear();
+	compiled = std::move(*tree);
+	compiled.links.clear();
+	compiled.links.shrink_to_fit();
+	compiled.joints.clear();
+	compiled.joints.shrink_to_fit();
+}
+
+const LinkValue* FrozenModel::getLink(std::string_view name) const {
+	int index = values.linkIndex(name);
+	return index < 0 ? nullptr : &values.links[index];
+}
+
+const JointValue* FrozenModel::getJoint(std::string_view name) const {
+	int index = values.jointIndex(name);
+	return index < 0 ? nullptr : &values.joints[index];
+}
+
+const Material* FrozenModel::getMaterial(std::string_view name) const {
+	int index = values.materialIndex(name);
+	return index < 0 ? nullptr : &(*materials)[index];
+}
+
+const LinkValue* FrozenModel::getParentLink(const LinkValue& link) const {
+	return link.parent_link < 0 ? nullptr : &values.links[link.parent_link];
+}
+
+const JointValue* FrozenModel::getParentJoint(const LinkValue& link) const {
+	return link.parent_joint < 0 ? nullptr : &values.joints[link.parent_joint];
+}
+
+const Material* FrozenModel::getMaterial(const VisualValue& visual) const {
+	return visual.material < 0 ? nullptr : &(*materials)[visual.material];
+}
+
+size_t FrozenModel::memoryUsage() const {
+	size_t bytes = sizeof(*this) + values.memoryUsage();
+	bytes += heapBytes(*materials);
+	for (const Material& material : *materials) {
+		bytes += heapBytes(material.texture_filename);
+	}
+	bytes += heapBytes(compiled.link_parent) + heapBytes(compiled.link_parent_joint);
+	bytes += heapBytes(compiled.joint_parent_link) + heapBytes(compiled.joint_child_link);
+	bytes += heapBytes(compiled.joint_type) + heapBytes(compiled.joint_axis);
+	bytes += heapBytes(compiled.joint_origin) + heapBytes(compiled.joint_position_index);
+	return bytes;
+}
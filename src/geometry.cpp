@@ -1,194 +1,194 @@
 #include "urdf/geometry.h"
 #include "urdf/link.h"
-#include <boost/algorithm/string.hpp>
-#include <boost/algorithm/string/trim.hpp>
-#include <boost/lexical_cast.hpp>
+#include "urdf/allocations.h"
 
 using namespace urdf;
 
 std::shared_ptr<Sphere> Sphere::fromXml(TiXmlElement *xml) {
+	ParseErrors errors(ParseErrors::THROW);
+	return fromXml(xml, errors);
+}
+
+std::shared_ptr<Sphere> Sphere::fromXml(TiXmlElement *xml, ParseErrors& errors) {
 	std::shared_ptr<Sphere> s = std::make_shared<Sphere>();
 
-	if (xml->Attribute("radius") != nullptr){
-		try{
-			string r = xml->Attribute("radius");
-			boost::algorithm::trim(r); // get rid of surrounding whitespace
-			s->radius = boost::lexical_cast<double>(r);
-		} catch (boost::bad_lexical_cast &e) {
-			std::ostringstream error_msg;
-			error_msg << "Error while parsing link '" << getParentLinkName(xml)
-			          << "': sphere radius [" << xml->Attribute("radius")
-			          << "] is not a valid float: " << e.what() << "!";
-			throw URDFParseError(error_msg.str());
+	const char* radius_str = xml->Attribute("radius");
+	if (radius_str != nullptr){
+		if (!parseDouble(radius_str, s->radius)) {
+			errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+			              "Error while parsing link '{}': sphere radius [{}] is not a valid float!",
+			              { getParentLinkName(xml), radius_str });
+			return nullptr;
 		}
 	} else {
-		std::ostringstream error_msg;
-		error_msg << "Error while parsing link '" << getParentLinkName(xml)
-		          << "': Sphere shape must have a radius attribute";
-		throw URDFParseError(error_msg.str());
+		errors.report(xml, ParseErrorCode::MISSING_ATTRIBUTE,
+		              "Error while parsing link '{}': Sphere shape must have a radius attribute",
+		              { getParentLinkName(xml) });
+		return nullptr;
 	}
 
 	return s;
 }
 
 std::shared_ptr<Box> Box::fromXml(TiXmlElement *xml) {
+	ParseErrors errors(ParseErrors::THROW);
+	return fromXml(xml, errors);
+}
+
+std::shared_ptr<Box> Box::fromXml(TiXmlElement *xml, ParseErrors& errors) {
 	std::shared_ptr<Box> b = std::make_shared<Box>();
 
-	if (xml->Attribute("size") != nullptr) {
-		try{
-			string r = xml->Attribute("size");
-			boost::algorithm::trim(r); // get rid of surrounding whitespace
-			b->dim = Vector3::fromVecStr(r);
-		}catch (URDFParseError &e) {
-			std::ostringstream error_msg;
-			error_msg << "Error while parsing link '" << getParentLinkName(xml)
-					  << "': box size [" << xml->Attribute("size")
-					  << "] is not a valid: " << e.what() << "!";
-			throw URDFParseError(error_msg.str());
+	const char* size_str = xml->Attribute("size");
+	if (size_str != nullptr) {
+		ParseError error;
+		if (!Vector3::fromVecStr(size_str, b->dim, error)) {
+			errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+			              "Error while parsing link '{}': box size [{}] is not a valid: {cause}!",
+			              { getParentLinkName(xml), size_str }, std::move(error));
+			return nullptr;
 		}
 	} else {
-		std::ostringstream error_msg;
-		error_msg << "Error while parsing link '" << getParentLinkName(xml)
-				  << "': Sphere shape must have a size attribute";
-		throw URDFParseError(error_msg.str());
+		errors.report(xml, ParseErrorCode::MISSING_ATTRIBUTE,
+		              "Error while parsing link '{}': Sphere shape must have a size attribute",
+		              { getParentLinkName(xml) });
+		return nullptr;
 	}
 
 	return b;
 }
 
 std::shared_ptr<Cylinder> Cylinder::fromXml(TiXmlElement *xml) {
-	std::shared_ptr<Cylinder> y = std::make_shared<Cylinder>();
+	ParseErrors errors(ParseErrors::THROW);
+	return fromXml(xml, errors);
+}
 
-	if (xml->Attribute("length") != nullptr && xml->Attribute("radius") != nullptr) {
-		try {
-			string r = xml->Attribute("length");
-			boost::algorithm::trim(r); // get rid of surrounding whitespace
-			y->length = boost::lexical_cast<double>(r);
-		} catch (boost::bad_lexical_cast &e) {
-			std::ostringstream error_msg;
-			error_msg << "Error while parsing link '" << getParentLinkName(xml)
-					  << "': cylinder length [" << xml->Attribute("length")
-					  << "] is not a valid float: " << e.what() << "!";
-			throw URDFParseError(error_msg.str());
+std::shared_ptr<Cylinder> Cylinder::fromXml(TiXmlElement *xml, ParseErrors& errors) {
+	std::shared_ptr<Cylinder> y = std::make_shared<Cylinder>();
+	size_t num_errors = errors.count();
+
+	const char* length_str = xml->Attribute("length");
+	const char* radius_str = xml->Attribute("radius");
+	if (length_str != nullptr && radius_str != nullptr) {
+		if (!parseDouble(length_str, y->length)) {
+			errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+			              "Error while parsing link '{}': cylinder length [{}] is not a valid float!",
+			              { getParentLinkName(xml), length_str });
 		}
 
-		try{
-			string r = xml->Attribute("radius");
-			boost::algorithm::trim(r); // get rid of surrounding whitespace
-			y->radius = boost::lexical_cast<double>(r);
-		} catch (boost::bad_lexical_cast &e) {
-			std::ostringstream error_msg;
-			error_msg << "Error while parsing link '" << getParentLinkName(xml)
-					  << "': cylinder radius [" << xml->Attribute("radius")
-					  << "] is not a valid float: " << e.what() << "!";
-			throw URDFParseError(error_msg.str());
+		if (!parseDouble(radius_str, y->radius)) {
+			errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+			              "Error while parsing link '{}': cylinder radius [{}] is not a valid float!",
+			              { getParentLinkName(xml), radius_str });
 		}
 	} else {
-		std::ostringstream error_msg;
-		error_msg << "Error while parsing link '" << getParentLinkName(xml)
-				  << "': Cylinder shape must have both length and radius attributes!";
-		throw URDFParseError(error_msg.str());
+		errors.report(xml, ParseErrorCode::MISSING_ATTRIBUTE,
+		              "Error while parsing link '{}': Cylinder shape must have both length and radius attributes!",
+		              { getParentLinkName(xml) });
 	}
 
-	return y;
+	return errors.count() == num_errors ? y : nullptr;
 }
 
 std::shared_ptr<Capsule> Capsule::fromXml(TiXmlElement *xml) {
-	std::shared_ptr<Capsule> y = std::make_shared<Capsule>();
+	ParseErrors errors(ParseErrors::THROW);
+	return fromXml(xml, errors);
+}
 
-	if (xml->Attribute("length") != nullptr && xml->Attribute("radius") != nullptr) {
-		try {
-			string r = xml->Attribute("length");
-			boost::algorithm::trim(r); // get rid of surrounding whitespace
-			y->length = boost::lexical_cast<double>(r);
-		} catch (boost::bad_lexical_cast &e) {
-			std::ostringstream error_msg;
-			error_msg << "Error while parsing link '" << getParentLinkName(xml)
-					  << "': capsule length [" << xml->Attribute("length")
-					  << "] is not a valid float: " << e.what() << "!";
-			throw URDFParseError(error_msg.str());
+std::shared_ptr<Capsule> Capsule::fromXml(TiXmlElement *xml, ParseErrors& errors) {
+	std::shared_ptr<Capsule> y = std::make_shared<Capsule>();
+	size_t num_errors = errors.count();
+
+	const char* length_str = xml->Attribute("length");
+	const char* radius_str = xml->Attribute("radius");
+	if (length_str != nullptr && radius_str != nullptr) {
+		if (!parseDouble(length_str, y->length)) {
+			errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+			              "Error while parsing link '{}': capsule length [{}] is not a valid float!",
+			              { getParentLinkName(xml), length_str });
 		}
 
-		try{
-			string r = xml->Attribute("radius");
-			boost::algorithm::trim(r); // get rid of surrounding whitespace
-			y->radius = boost::lexical_cast<double>(r);
-		} catch (boost::bad_lexical_cast &e) {
-			std::ostringstream error_msg;
-			error_msg << "Error while parsing link '" << getParentLinkName(xml)
-					  << "': capsule radius [" << xml->Attribute("radius")
-					  << "] is not a valid float: " << e.what() << "!";
-			throw URDFParseError(error_msg.str());
+		if (!parseDouble(radius_str, y->radius)) {
+			errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+			              "Error while parsing link '{}': capsule radius [{}] is not a valid float!",
+			              { getParentLinkName(xml), radius_str });
 		}
 	} else {
-		std::ostringstream error_msg;
-		error_msg << "Error while parsing link '" << getParentLinkName(xml)
-				  << "': Capsule shape must have both length and radius attributes!";
-		throw URDFParseError(error_msg.str());
+		errors.report(xml, ParseErrorCode::MISSING_ATTRIBUTE,
+		              "Error while parsing link '{}': Capsule shape must have both length and radius attributes!",
+		              { getParentLinkName(xml) });
 	}
 
-	return y;
+	return errors.count() == num_errors ? y : nullptr;
 }
 
 std::shared_ptr<Mesh> Mesh::fromXml(TiXmlElement *xml) {
+	ParseErrors errors(ParseErrors::THROW);
+	return fromXml(xml, errors);
+}
+
+std::shared_ptr<Mesh> Mesh::fromXml(TiXmlElement *xml, ParseErrors& errors) {
 	std::shared_ptr<Mesh> m = std::make_shared<Mesh>();
+	size_t num_errors = errors.count();
 
 	if (xml->Attribute("filename") != nullptr) {
+		AllocationScope strings(AllocationSubsystem::STRINGS);
 		m->filename = xml->Attribute("filename");
 	} else {
-		std::ostringstream error_msg;
-		error_msg << "Error while parsing link '" << getParentLinkName(xml)
-				  << "Mesh must contain a filename attribute!";
-		throw URDFParseError(error_msg.str());
+		errors.report(xml, ParseErrorCode::MISSING_ATTRIBUTE,
+		              "Error while parsing link '{}Mesh must contain a filename attribute!",
+		              { getParentLinkName(xml) });
 	}
 
-	if (xml->Attribute("scale") != nullptr) {
-		try {
-			string r = xml->Attribute("scale");
-			boost::algorithm::trim(r); // get rid of surrounding whitespace
-			m->scale = Vector3::fromVecStr(r);
-		} catch (URDFParseError &e) {
-			std::ostringstream error_msg;
-			error_msg << "Error while parsing link '" << getParentLinkName(xml)
-					  << "': mesh scale [" << xml->Attribute("scale")
-					  << "] is not a valid: " << e.what() << "!";
-			throw URDFParseError(error_msg.str());
+	const char* scale_str = xml->Attribute("scale");
+	if (scale_str != nullptr) {
+		ParseError error;
+		if (!Vector3::fromVecStr(scale_str, m->scale, error)) {
+			errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+			              "Error while parsing link '{}': mesh scale [{}] is not a valid: {cause}!",
+			              { getParentLinkName(xml), scale_str }, std::move(error));
 		}
 	}
-	return m;
+
+	return errors.count() == num_errors ? m : nullptr;
 }
 
 std::shared_ptr<Geometry> Geometry::fromXml(TiXmlElement *xml) {
+	ParseErrors errors(ParseErrors::THROW);
+	return fromXml(xml, errors);
+}
+
+std::shared_ptr<Geometry> Geometry::fromXml(TiXmlElement *xml, ParseErrors& errors) {
+	AllocationScope geometry(AllocationSubsystem::GEOMETRY);
 	if (xml == nullptr) {
-		std::ostringstream error_msg;
-		error_msg << "Error while parsing link '" << getParentLinkName(xml)
-		          << "' geometry structure pointer is null nothing to parse!";
-		throw URDFParseError(error_msg.str());
+		errors.report(xml, ParseErrorCode::MISSING_ELEMENT,
+		              "Error while parsing link '{}' geometry structure pointer is null nothing to parse!",
+		              { "" });
+		return nullptr;
 	}
 
 	TiXmlElement *shape = xml->FirstChildElement();
 	if (shape == nullptr) {
-		std::ostringstream error_msg;
-		error_msg << "Error while parsing link '" << getParentLinkName(xml)
-		          << "' geometry does not contain any shape information!";
-		throw URDFParseError(error_msg.str());
+		errors.report(xml, ParseErrorCode::MISSING_ELEMENT,
+		              "Error while parsing link '{}' geometry does not contain any shape information!",
+		              { getParentLinkName(xml) });
+		return nullptr;
 	}
 
-	const std::string type_name = shape->ValueTStr().c_str();
+	const std::string &type_name = shape->ValueStr();
 	if (type_name == "sphere") {
-		return Sphere::fromXml(shape);
+		return Sphere::fromXml(shape, errors);
 	} else if (type_name == "box") {
-		return Box::fromXml(shape);
+		return Box::fromXml(shape, errors);
 	} else if (type_name == "cylinder") {
-		return Cylinder::fromXml(shape);
-    } else if (type_name == "capsule") {
-		return Capsule::fromXml(shape);
+		return Cylinder::fromXml(shape, errors);
+	} else if (type_name == "capsule") {
+		return Capsule::fromXml(shape, errors);
 	} else if (type_name == "mesh") {
-		return Mesh::fromXml(shape);
+		return Mesh::fromXml(shape, errors);
 	} else {
-		std::ostringstream error_msg;
-		error_msg << "Error while parsing link '" << getParentLinkName(xml)
-		          << "' unknown shape type '" << type_name << "'!";
-		throw URDFParseError(error_msg.str());
+		errors.report(shape, ParseErrorCode::INVALID_VALUE,
+		              "Error while parsing link '{}' unknown shape type '{}'!",
+		              { getParentLinkName(xml), type_name });
+		return nullptr;
 	}
 }
@@ -1,290 +1,276 @@
 #include "urdf/joint.h"
-#include <boost/algorithm/string.hpp>
-#include <boost/lexical_cast.hpp>
 
 namespace urdf{
 
 	const char* getParentJointName(TiXmlElement* xml) {
 		// this should always be set since we check for the joint name in parseJoint already
-		return ((TiXmlElement*)xml->Parent())->Attribute("name");
+		const char* name = ((TiXmlElement*)xml->Parent())->Attribute("name");
+		return name != NULL ? name : "";
 	}
 
 // ------------------- JointDynamics Implementation -------------------
 
 	std::shared_ptr<JointDynamics> JointDynamics::fromXml(TiXmlElement* xml) {
+		ParseErrors errors(ParseErrors::THROW);
+		return fromXml(xml, errors);
+	}
+
+	std::shared_ptr<JointDynamics> JointDynamics::fromXml(TiXmlElement* xml, ParseErrors& errors) {
 		std::shared_ptr<JointDynamics> jd = std::make_shared<JointDynamics>();
+		size_t num_errors = errors.count();
+
 		const char* damping_str = xml->Attribute("damping");
 		if (damping_str != NULL){
-			try {
-				jd->damping = boost::lexical_cast<double>(damping_str);
-			} catch (boost::bad_lexical_cast &e) {
-				std::ostringstream error_msg;
-				error_msg << "Error while parsing joint '" << getParentJointName(xml)
-				          << "': dynamics damping value (" << damping_str
-				          << ") is not a float: " << e.what() << "!";
-				throw URDFParseError(error_msg.str());
+			if (!parseDouble(damping_str, jd->damping)) {
+				errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+				              "Error while parsing joint '{}': dynamics damping value ({}) is not a float!",
+				              { getParentJointName(xml), damping_str });
 			}
 		}
 
 		const char* friction_str = xml->Attribute("friction");
 		if (friction_str != NULL){
-			try {
-				jd->friction = boost::lexical_cast<double>(friction_str);
-			} catch (boost::bad_lexical_cast &e) {
-				std::ostringstream error_msg;
-				error_msg << "Error while parsing joint '" << getParentJointName(xml)
-				          << "': dynamics friction value (" << friction_str
-				          << ") is not a float: " << e.what() << "!";
-				throw URDFParseError(error_msg.str());
+			if (!parseDouble(friction_str, jd->friction)) {
+				errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+				              "Error while parsing joint '{}': dynamics friction value ({}) is not a float!",
+				              { getParentJointName(xml), friction_str });
 			}
 		}
 
 		if (damping_str == NULL && friction_str == NULL) {
-			std::ostringstream error_msg;
-			error_msg << "Error while parsing joint '" << getParentJointName(xml)
-					  << "': joint dynamics element specified with no damping and no friction!";
-			throw URDFParseError(error_msg.str());
+			errors.report(xml, ParseErrorCode::MISSING_ATTRIBUTE,
+			              "Error while parsing joint '{}': joint dynamics element specified with no damping and no friction!",
+			              { getParentJointName(xml) });
 		}
 
-		return jd;
+		return errors.count() == num_errors ? jd : nullptr;
 	}
 
 // ------------------- JointLimits Implementation -------------------
 
 	std::shared_ptr<JointLimits> JointLimits::fromXml(TiXmlElement* xml) {
+		ParseErrors errors(ParseErrors::THROW);
+		return fromXml(xml, errors);
+	}
+
+	std::shared_ptr<JointLimits> JointLimits::fromXml(TiXmlElement* xml, ParseErrors& errors) {
 		std::shared_ptr<JointLimits> jl = std::make_shared<JointLimits>();
+		size_t num_errors = errors.count();
+
+		static const char* const names[4] = { "lower", "upper", "effort", "velocity" };
+		const char* values[4];
+		xml->Attributes(names, values, 4);
 
-		const char* lower_str = xml->Attribute("lower");
+		const char* lower_str = values[0];
 		if (lower_str != NULL){
-			try {
-				jl->lower = boost::lexical_cast<double>(lower_str);
-			} catch (boost::bad_lexical_cast &e) {
-				std::ostringstream error_msg;
-				error_msg << "Error while parsing joint '" << getParentJointName(xml)
-				          << "': limits lower value (" << lower_str
-				          << ") is not a float: " << e.what() << "!";
-				throw URDFParseError(error_msg.str());
+			if (!parseDouble(lower_str, jl->lower)) {
+				errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+				              "Error while parsing joint '{}': limits lower value ({}) is not a float!",
+				              { getParentJointName(xml), lower_str });
 			}
 		}
 
-		const char* upper_str = xml->Attribute("upper");
+		const char* upper_str = values[1];
 		if (upper_str != NULL){
-			try {
-				jl->upper = boost::lexical_cast<double>(upper_str);
-			} catch (boost::bad_lexical_cast &e) {
-				std::ostringstream error_msg;
-				error_msg << "Error while parsing joint '" << getParentJointName(xml)
-						  << "': limits upper value (" << upper_str
-						  << ") is not a float: " << e.what() << "!";
-				throw URDFParseError(error_msg.str());
+			if (!parseDouble(upper_str, jl->upper)) {
+				errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+				              "Error while parsing joint '{}': limits upper value ({}) is not a float!",
+				              { getParentJointName(xml), upper_str });
 			}
 		}
 
-		const char* effort_str = xml->Attribute("effort");
+		const char* effort_str = values[2];
 		if (effort_str != NULL){
-			try {
-				jl->effort = boost::lexical_cast<double>(effort_str);
-			} catch (boost::bad_lexical_cast &e){
-				std::ostringstream error_msg;
-				error_msg << "Error while parsing joint '" << getParentJointName(xml)
-						  << "' limits effort value (" << effort_str
-						  << ") is not a float: " << e.what() << "!";
-				throw URDFParseError(error_msg.str());
+			if (!parseDouble(effort_str, jl->effort)) {
+				errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+				              "Error while parsing joint '{}' limits effort value ({}) is not a float!",
+				              { getParentJointName(xml), effort_str });
 			}
 		} else {
-			std::ostringstream error_msg;
-			error_msg << "Error while parsing joint '" << getParentJointName(xml)
-					  << "' joint limit: no effort specified!";
-			throw URDFParseError(error_msg.str());
+			errors.report(xml, ParseErrorCode::MISSING_ATTRIBUTE,
+			              "Error while parsing joint '{}' joint limit: no effort specified!",
+			              { getParentJointName(xml) });
 		}
 
-		const char* velocity_str = xml->Attribute("velocity");
+		const char* velocity_str = values[3];
 		if (velocity_str != NULL){
-			try {
-				jl->velocity = boost::lexical_cast<double>(velocity_str);
-			} catch (boost::bad_lexical_cast &e) {
-				std::ostringstream error_msg;
-				error_msg << "Error while parsing joint '" << getParentJointName(xml)
-						  << "' limits velocity value (" << velocity_str
-						  << ") is not a float: " << e.what() << "!";
-				throw URDFParseError(error_msg.str());
+			if (!parseDouble(velocity_str, jl->velocity)) {
+				errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+				              "Error while parsing joint '{}' limits velocity value ({}) is not a float!",
+				              { getParentJointName(xml), velocity_str });
 			}
 		} else {
-			std::ostringstream error_msg;
-			error_msg << "Error while parsing joint '" << getParentJointName(xml)
-					  << "' joint limit: no velocity specified!";
-			throw URDFParseError(error_msg.str());
+			errors.report(xml, ParseErrorCode::MISSING_ATTRIBUTE,
+			              "Error while parsing joint '{}' joint limit: no velocity specified!",
+			              { getParentJointName(xml) });
 		}
 
-		return jl;
+		return errors.count() == num_errors ? jl : nullptr;
 	}
 
 // ------------------- JointSafety Implementation -------------------
 
 	std::shared_ptr<JointSafety> JointSafety::fromXml(TiXmlElement* xml) {
+		ParseErrors errors(ParseErrors::THROW);
+		return fromXml(xml, errors);
+	}
+
+	std::shared_ptr<JointSafety> JointSafety::fromXml(TiXmlElement* xml, ParseErrors& errors) {
 		std::shared_ptr<JointSafety> js = std::make_shared<JointSafety>();
+		size_t num_errors = errors.count();
+
+		static const char* const names[4] = { "lower_limit", "upper_limit", "k_position", "k_velocity" };
+		const char* values[4];
+		xml->Attributes(names, values, 4);
 
-		const char* lower_limit_str = xml->Attribute("lower_limit");
+		const char* lower_limit_str = values[0];
 		if (lower_limit_str != NULL) {
-			try {
-				js->lower_limit = boost::lexical_cast<double>(lower_limit_str);
-			} catch (boost::bad_lexical_cast &e) {
-				std::ostringstream error_msg;
-				error_msg << "Error while parsing joint '" << getParentJointName(xml)
-						  << "' safety lower_limit value (" << lower_limit_str
-						  << ") is not a float: " << e.what() << "!";
-				throw URDFParseError(error_msg.str());
+			if (!parseDouble(lower_limit_str, js->lower_limit)) {
+				errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+				              "Error while parsing joint '{}' safety lower_limit value ({}) is not a float!",
+				              { getParentJointName(xml), lower_limit_str });
 			}
 		}
 
-		const char* upper_limit_str = xml->Attribute("upper_limit");
+		const char* upper_limit_str = values[1];
 		if (upper_limit_str != NULL){
-			try {
-				js->upper_limit = boost::lexical_cast<double>(upper_limit_str);
-			} catch (boost::bad_lexical_cast &e) {
-				std::ostringstream error_msg;
-				error_msg << "Error while parsing joint '" << getParentJointName(xml)
-						  << "' safety upper_limit value (" << upper_limit_str
-						  << ") is not a float: " << e.what() << "!";
-				throw URDFParseError(error_msg.str());
+			if (!parseDouble(upper_limit_str, js->upper_limit)) {
+				errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+				              "Error while parsing joint '{}' safety upper_limit value ({}) is not a float!",
+				              { getParentJointName(xml), upper_limit_str });
 			}
 		}
 
-		const char* k_position_str = xml->Attribute("k_position");
+		const char* k_position_str = values[2];
 		if (k_position_str != NULL) {
-			try {
-				js->k_position = boost::lexical_cast<double>(k_position_str);
-			} catch (boost::bad_lexical_cast &e) {
-				std::ostringstream error_msg;
-				error_msg << "Error while parsing joint '" << getParentJointName(xml)
-						  << "' safety k_position value (" << k_position_str
-						  << ") is not a float: " << e.what() << "!";
-				throw URDFParseError(error_msg.str());
+			if (!parseDouble(k_position_str, js->k_position)) {
+				errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+				              "Error while parsing joint '{}' safety k_position value ({}) is not a float!",
+				              { getParentJointName(xml), k_position_str });
 			}
 		}
 
-		const char* k_velocity_str = xml->Attribute("k_velocity");
+		const char* k_velocity_str = values[3];
 		if (k_velocity_str != NULL) {
-			try {
-				js->k_velocity = boost::lexical_cast<double>(k_velocity_str);
-			} catch (boost::bad_lexical_cast &e) {
-				std::ostringstream error_msg;
-				error_msg << "Error while parsing joint '" << getParentJointName(xml)
-						  << "' safety k_velocity value (" << k_velocity_str
-						  << ") is not a float: " << e.what() << "!";
-				throw URDFParseError(error_msg.str());
+			if (!parseDouble(k_velocity_str, js->k_velocity)) {
+				errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+				              "Error while parsing joint '{}' safety k_velocity value ({}) is not a float!",
+				              { getParentJointName(xml), k_velocity_str });
 			}
 		} else {
-			std::ostringstream error_msg;
-			error_msg << "Error while parsing joint '" << getParentJointName(xml)
-					  << "' joint safety no k_velocity!";
-			throw URDFParseError(error_msg.str());
+			errors.report(xml, ParseErrorCode::MISSING_ATTRIBUTE,
+			              "Error while parsing joint '{}' joint safety no k_velocity!",
+			              { getParentJointName(xml) });
 		}
 
-		return js;
+		return errors.count() == num_errors ? js : nullptr;
 	}
 
 // ------------------- JointCalibration Implementation -------------------
 
 	std::shared_ptr<JointCalibration> JointCalibration::fromXml(TiXmlElement* xml) {
+		ParseErrors errors(ParseErrors::THROW);
+		return fromXml(xml, errors);
+	}
+
+	std::shared_ptr<JointCalibration> JointCalibration::fromXml(TiXmlElement* xml, ParseErrors& errors) {
 		std::shared_ptr<JointCalibration> jc = std::make_shared<JointCalibration>();
+		size_t num_errors = errors.count();
 
 		const char* rising_str = xml->Attribute("rising");
 		if (rising_str != NULL) {
-			try {
-				jc->rising = boost::lexical_cast<double>(rising_str);
-			} catch (boost::bad_lexical_cast &e) {
-				std::ostringstream error_msg;
-				error_msg << "Error while parsing joint '" << getParentJointName(xml)
-						  << "' calibration rising_position value (" << rising_str
-						  << ") is not a float: " << e.what() << "!";
-				throw URDFParseError(error_msg.str());
+			double rising;
+			if (parseDouble(rising_str, rising)) {
+				jc->rising = rising;
+			} else {
+				errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+				              "Error while parsing joint '{}' calibration rising_position value ({}) is not a float!",
+				              { getParentJointName(xml), rising_str });
 			}
 		}
 
 		const char* falling_str = xml->Attribute("falling");
 		if (falling_str != NULL) {
-			try {
-				jc->falling = boost::lexical_cast<double>(falling_str);
-			} catch (boost::bad_lexical_cast &e) {
-				std::ostringstream error_msg;
-				error_msg << "Error while parsing joint '" << getParentJointName(xml)
-						  << "' calibration falling_position value (" << falling_str
-						  << ") is not a float: " << e.what() << "!";
-				throw URDFParseError(error_msg.str());
+			double falling;
+			if (parseDouble(falling_str, falling)) {
+				jc->falling = falling;
+			} else {
+				errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+				              "Error while parsing joint '{}' calibration falling_position value ({}) is not a float!",
+				              { getParentJointName(xml), falling_str });
 			}
 		}
 
-		return jc;
+		return errors.count() == num_errors ? jc : nullptr;
 	}
 
 // ------------------- JointMimic Implementation -------------------
 
 	std::shared_ptr<JointMimic> JointMimic::fromXml(TiXmlElement* xml) {
+		ParseErrors errors(ParseErrors::THROW);
+		return fromXml(xml, errors);
+	}
+
+	std::shared_ptr<JointMimic> JointMimic::fromXml(TiXmlElement* xml, ParseErrors& errors) {
 		std::shared_ptr<JointMimic> jm = std::make_shared<JointMimic>();
+		size_t num_errors = errors.count();
 
 		const char* joint_name_str = xml->Attribute("joint");
 		if (joint_name_str != NULL) {
 			jm->joint_name = joint_name_str;
 		} else {
-			std::ostringstream error_msg;
-			error_msg << "Error while parsing joint '" << getParentJointName(xml)
-					  << "joint mimic: no mimic joint specified!";
-			throw URDFParseError(error_msg.str());
+			errors.report(xml, ParseErrorCode::MISSING_ATTRIBUTE,
+			              "Error while parsing joint '{}joint mimic: no mimic joint specified!",
+			              { getParentJointName(xml) });
 		}
 
 		const char* multiplier_str = xml->Attribute("multiplier");
 		if (multiplier_str != NULL) {
-			try {
-				jm->multiplier = boost::lexical_cast<double>(multiplier_str);
-			} catch (boost::bad_lexical_cast &e) {
-				std::ostringstream error_msg;
-				error_msg << "Error while parsing joint '" << getParentJointName(xml)
-						  << "' mimic multiplier value (" << multiplier_str
-						  << ") is not a float: " << e.what() << "!";
-				throw URDFParseError(error_msg.str());
+			if (!parseDouble(multiplier_str, jm->multiplier)) {
+				errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+				              "Error while parsing joint '{}' mimic multiplier value ({}) is not a float!",
+				              { getParentJointName(xml), multiplier_str });
 			}
 		}
 
 		const char* offset_str = xml->Attribute("offset");
 		if (offset_str != NULL) {
-			try {
-				jm->offset = boost::lexical_cast<double>(offset_str);
-			} catch (boost::bad_lexical_cast &e) {
-				std::ostringstream error_msg;
-				error_msg << "Error while parsing joint '" << getParentJointName(xml)
-						  << "' mimic offset value (" << offset_str
-						  << ") is not a float: " << e.what() << "!";
-				throw URDFParseError(error_msg.str());
+			if (!parseDouble(offset_str, jm->offset)) {
+				errors.report(xml, ParseErrorCode::INVALID_NUMBER,
+				              "Error while parsing joint '{}' mimic offset value ({}) is not a float!",
+				              { getParentJointName(xml), offset_str });
 			}
 		}
 
-		return jm;
+		return errors.count() == num_errors ? jm : nullptr;
 	}
 
 // ------------------- Joint Implementation -------------------
 
 	std::shared_ptr<Joint> Joint::fromXml(TiXmlElement* xml) {
+		ParseErrors errors(ParseErrors::THROW);
+		return fromXml(xml, errors);
+	}
+
+	std::shared_ptr<Joint> Joint::fromXml(TiXmlElement* xml, ParseErrors& errors) {
 		std::shared_ptr<Joint> joint = std::make_shared<Joint>();
+		size_t num_errors = errors.count();
 
 		const char *name = xml->Attribute("name");
 		if (name != NULL) {
 			joint->name = name;
 		} else {
-			std::ostringstream error_msg;
-			error_msg << "Error while parsing model: unnamed joint found!";
-			throw URDFParseError(error_msg.str());
+			errors.report(xml, ParseErrorCode::MISSING_ATTRIBUTE,
+			              "Error while parsing model: unnamed joint found!");
 		}
 
 		TiXmlElement *origin_xml = xml->FirstChildElement("origin");
 		if (origin_xml != NULL) {
-			try {
-				joint->parent_to_joint_transform =  Transform::fromXml(origin_xml);
-			} catch (urdf::URDFParseError& e) {
-				std::ostringstream error_msg;
-				error_msg << "Error! Malformed parent origin element for joint '" << joint->name
-						  << "': " << e.what() << "!";
-				throw URDFParseError(error_msg.str());
+			ParseError error;
+			if (!Transform::fromXml(origin_xml, joint->parent_to_joint_transform, error)) {
+				errors.report(origin_xml, ParseErrorCode::INVALID_NUMBER,
+				              "Error! Malformed parent origin element for joint '{}': {cause}!",
+				              { joint->name }, std::move(error));
 			}
 		}
 
@@ -292,7 +278,7 @@ namespace urdf{
 		if (parent_xml != NULL) {
 			const char *pname = parent_xml->Attribute("link");
 			if (pname != NULL) {
-				joint->parent_link_name = std::string(pname);
+				joint->parent_link_name = pname;
 			}
 			// if no parent link name specified. this might be the root node
 		}
@@ -302,19 +288,19 @@ namespace urdf{
 		{
 			const char *pname = child_xml->Attribute("link");
 			if (pname != NULL) {
-				joint->child_link_name = std::string(pname);
+				joint->child_link_name = pname;
 			}
 		}
 
 		const char* type_char = xml->Attribute("type");
 		if (type_char == NULL) {
-			std::ostringstream error_msg;
-			error_msg << "Error! Joint " << joint->name
-					  <<" has no type, check to see if it's a reference.";
-			throw URDFParseError(error_msg.str());
+			errors.report(xml, ParseErrorCode::MISSING_ATTRIBUTE,
+			              "Error! Joint {} has no type, check to see if it's a reference.",
+			              { joint->name });
+			return nullptr;
 		}
 
-		std::string type_str = type_char;
+		std::string_view type_str = type_char;
 		if (type_str == "planar")
 			joint->type = JointType::PLANAR;
 		else if (type_str == "floating")
@@ -328,10 +314,10 @@ namespace urdf{
 		else if (type_str == "fixed")
 			joint->type = JointType::FIXED;
 		else {
-			std::ostringstream error_msg;
-			error_msg << "Error! Joint '" << joint->name
-					  <<"' has unknown type (" << type_str << ")!";
-			throw URDFParseError(error_msg.str());
+			errors.report(xml, ParseErrorCode::INVALID_VALUE,
+			              "Error! Joint '{}' has unknown type ({})!",
+			              { joint->name, type_str });
+			return nullptr;
 		}
 
 		if (joint->type != JointType::FLOATING && joint->type != JointType::FIXED)
@@ -341,13 +327,11 @@ namespace urdf{
 				joint->axis = Vector3(1.0, 0.0, 0.0);
 			} else {
 				if (axis_xml->Attribute("xyz")){
-					try {
-						joint->axis = Vector3::fromVecStr(axis_xml->Attribute("xyz"));
-					} catch (URDFParseError &e) {
-						std::ostringstream error_msg;
-						error_msg << "Error! Malformed axis element for joint ["<< joint->name
-								  << "]: " << e.what();
-						throw URDFParseError(error_msg.str());
+					ParseError error;
+					if (!Vector3::fromVecStr(axis_xml->Attribute("xyz"), joint->axis, error)) {
+						errors.report(axis_xml, ParseErrorCode::INVALID_NUMBER,
+						              "Error! Malformed axis element for joint [{}]: {cause}",
+						              { joint->name }, std::move(error));
 					}
 				}
 			}
@@ -355,29 +339,44 @@ namespace urdf{
 
 		TiXmlElement *prop_xml = xml->FirstChildElement("dynamics");
 		if (prop_xml != NULL) {
-			joint->dynamics = JointDynamics::fromXml(prop_xml);
+			auto dynamics = JointDynamics::fromXml(prop_xml, errors);
+			if (dynamics != nullptr) {
+				joint->dynamics = dynamics;
+			}
 		}
 
 		TiXmlElement *limit_xml = xml->FirstChildElement("limit");
 		if (limit_xml != NULL) {
-			joint->limits = JointLimits::fromXml(limit_xml);
+			auto limits = JointLimits::fromXml(limit_xml, errors);
+			if (limits != nullptr) {
+				joint->limits = limits;
+			}
 		}
 
 		TiXmlElement *safety_xml = xml->FirstChildElement("safety_controller");
 		if (safety_xml != NULL) {
-			joint->safety = JointSafety::fromXml(safety_xml);
+			auto safety = JointSafety::fromXml(safety_xml, errors);
+			if (safety != nullptr) {
+				joint->safety = safety;
+			}
 		}
 
 		TiXmlElement *calibration_xml = xml->FirstChildElement("calibration");
 		if (calibration_xml != NULL) {
-			joint->calibration = JointCalibration::fromXml(calibration_xml);
+			auto calibration = JointCalibration::fromXml(calibration_xml, errors);
+			if (calibration != nullptr) {
+				joint->calibration = calibration;
+			}
 		}
 
 		TiXmlElement *mimic_xml = xml->FirstChildElement("mimic");
 		if (mimic_xml != NULL) {
-			joint->mimic = JointMimic::fromXml(mimic_xml);
+			auto mimic = JointMimic::fromXml(mimic_xml, errors);
+			if (mimic != nullptr) {
+				joint->mimic = mimic;
+			}
 		}
 
-		return joint;
+		return errors.count() == num_errors ? joint : nullptr;
 	}
 }
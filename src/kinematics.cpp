@@ -0,0 +1,101 @@
+#include "urdf/kinematics.h"
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace urdf;
+
+namespace {
+	Vector3 normalized(const Vector3& v) {
+		double norm = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+		if (norm == 0.) {
+			return v;
+		}
+		return Vector3(v.x / norm, v.y / norm, v.z / norm);
+	}
+
+	Rotation axisAngle(const Vector3& axis, double angle) {
+		double s = std::sin(0.5 * angle);
+		return Rotation(axis.x * s, axis.y * s, axis.z * s, std::cos(0.5 * angle));
+	}
+
+	// Motion of the child frame relative to the joint frame.
+	Transform jointMotion(JointType type, const Vector3& joint_axis, const double* q) {
+		Transform motion;
+		Vector3 axis = normalized(joint_axis);
+		switch (type) {
+			case JointType::REVOLUTE:
+			case JointType::CONTINUOUS:
+				motion.rotation = axisAngle(axis, q[0]);
+				break;
+			case JointType::PRISMATIC:
+				motion.position = Vector3(axis.x * q[0], axis.y * q[0], axis.z * q[0]);
+				break;
+			case JointType::FLOATING:
+				motion.position = Vector3(q[0], q[1], q[2]);
+				motion.rotation = Rotation(q[3], q[4], q[5], q[6]);
+				// integrated or interpolated quaternions drift off unit length
+				motion.rotation.normalize();
+				break;
+			case JointType::PLANAR: {
+				// translate along two directions u, v spanning the plane normal to the
+				// axis, built from the coordinate axis least aligned with it
+				Vector3 seed(1., 0., 0.);
+				if (std::fabs(axis.y) < std::fabs(axis.x) && std::fabs(axis.y) <= std::fabs(axis.z)) {
+					seed = Vector3(0., 1., 0.);
+				} else if (std::fabs(axis.z) < std::fabs(axis.x) && std::fabs(axis.z) < std::fabs(axis.y)) {
+					seed = Vector3(0., 0., 1.);
+				}
+				double d = seed.x * axis.x + seed.y * axis.y + seed.z * axis.z;
+				Vector3 u = normalized(Vector3(seed.x - d * axis.x, seed.y - d * axis.y, seed.z - d * axis.z));
+				Vector3 v(axis.y * u.z - axis.z * u.y, axis.z * u.x - axis.x * u.z, axis.x * u.y - axis.y * u.x);
+				motion.position = Vector3(u.x * q[0] + v.x * q[1], u.y * q[0] + v.y * q[1], u.z * q[0] + v.z * q[1]);
+				motion.rotation = axisAngle(axis, q[2]);
+				break;
+			}
+			default:
+				break;
+		}
+		return motion;
+	}
+}
+
+void urdf::forwardKinematics(const CompiledModel& model, const double* q, Transform* link_poses) {
+	size_t num_joints = model.numJoints();
+	if (model.numLinks() == 0) {
+		return;
+	}
+
+	link_poses[0] = Transform();
+	for (size_t j = 0; j < num_joints; j++) {
+		const Transform& parent = link_poses[model.joint_parent_link[j]];
+		Transform joint_frame = parent * model.joint_origin[j];
+
+		JointType type = model.joint_type[j];
+		if (CompiledModel::jointPositionCount(type) == 0) {
+			link_poses[model.joint_child_link[j]] = joint_frame;
+		} else {
+			const double* joint_q = q + model.joint_position_index[j];
+			link_poses[model.joint_child_link[j]] = joint_frame * jointMotion(type, model.joint_axis[j], joint_q);
+		}
+	}
+}
+
+void urdf::forwardKinematics(const CompiledModel& model, const double* q, size_t num_configurations,
+                             Transform* link_poses) {
+	size_t num_positions = model.numPositions();
+	size_t num_links = model.numLinks();
+	for (size_t c = 0; c < num_configurations; c++) {
+		forwardKinematics(model, q + c * num_positions, link_poses + c * num_links);
+	}
+}
+
+std::vector<Transform> urdf::forwardKinematics(const CompiledModel& model, const std::vector<double>& q) {
+	if (q.size() != model.numPositions()) {
+		throw std::invalid_argument("forwardKinematics: expected " + std::to_string(model.numPositions()) +
+		                            " joint positions but got " + std::to_string(q.size()));
+	}
+	std::vector<Transform> link_poses(model.numLinks());
+	forwardKinematics(model, q.data(), link_poses.data());
+	return link_poses;
+}
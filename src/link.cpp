@@ -1,12 +1,15 @@
 #include "tinyxml/txml.h"
 #include "urdf/link.h"
-
-#include <boost/algorithm/string.hpp>
-#include <boost/lexical_cast.hpp>
+#include "urdf/allocations.h"
 
 namespace urdf{
 
 	std::shared_ptr<Material> Material::fromXml(TiXmlElement *xml, bool only_name_is_ok) {
+		ParseErrors errors(ParseErrors::THROW);
+		return fromXml(xml, only_name_is_ok, errors);
+	}
+
+	std::shared_ptr<Material> Material::fromXml(TiXmlElement *xml, bool only_name_is_ok, ParseErrors& errors) {
 		bool has_rgb = false;
 		bool has_filename = false;
 
@@ -16,15 +19,16 @@ namespace urdf{
 		if (name_str != NULL) {
 			m->name = name_str;
 		} else {
-			std::ostringstream error_msg;
-			error_msg << "Error! Material without a name attribute detected!";
-			throw URDFParseError(error_msg.str());
+			errors.report(xml, ParseErrorCode::MISSING_ATTRIBUTE,
+			              "Error! Material without a name attribute detected!");
+			return nullptr;
 		}
 
 
 		auto t = xml->FirstChildElement("texture");
 		if (t != NULL) {
 			if (t->Attribute("filename") != NULL) {
+				AllocationScope strings(AllocationSubsystem::STRINGS);
 				m->texture_filename = t->Attribute("filename");
 				has_filename = true;
 			}
@@ -33,26 +37,24 @@ namespace urdf{
 		auto c = xml->FirstChildElement("color");
 		if (c != NULL) {
 			if (c->Attribute("rgba") != nullptr) {
-				try {
-					m->color = Color::fromColorStr(c->Attribute("rgba"));
-					has_rgb = true;
-				} catch (URDFParseError &e) {
-					std::ostringstream error_msg;
-					error_msg << "Material [" << m->name
-							  << "] has malformed color rgba values: "
-							  << e.what() << "!";
-					throw URDFParseError(error_msg.str());
+				ParseError error;
+				if (!Color::fromColorStr(c->Attribute("rgba"), m->color, error)) {
+					errors.report(c, ParseErrorCode::INVALID_NUMBER,
+					              "Material [{}] has malformed color rgba values: {cause}!",
+					              { m->name }, std::move(error));
+					return nullptr;
 				}
+				has_rgb = true;
 			}
 		}
 
 		if (!has_rgb && !has_filename) {
 			if (!only_name_is_ok) // no need for an error if only name is ok
 			{
-				std::ostringstream error_msg;
-				error_msg << "Material [" << m->name
-						  << "] has neither a texture nor a color defined!";
-				throw URDFParseError(error_msg.str());
+				errors.report(xml, ParseErrorCode::MISSING_ELEMENT,
+				              "Material [{}] has neither a texture nor a color defined!",
+				              { m->name });
+				return nullptr;
 			}
 		}
 
@@ -67,107 +69,113 @@ namespace urdf{
 			}
 			e = e->Parent()->ToElement();
 		}
-		return e->Attribute("name");
+		const char* name = e->Attribute("name");
+		return name != nullptr ? name : "";
 	}
 
 
-  Inertial Inertial::fromXml(TiXmlElement *xml) {
+	Inertial Inertial::fromXml(TiXmlElement *xml) {
+		ParseErrors errors(ParseErrors::THROW);
+		return fromXml(xml, errors).value();
+	}
+
+	std::optional<Inertial> Inertial::fromXml(TiXmlElement *xml, ParseErrors& errors) {
 		Inertial i;
+		size_t num_errors = errors.count();
 
 		TiXmlElement *o = xml->FirstChildElement("origin");
 		if (o != nullptr) {
-			i.origin = Transform::fromXml(o);
+			ParseError error;
+			if (!Transform::fromXml(o, i.origin, error)) {
+				errors.report(o, std::move(error));
+			}
 		}
 
 		TiXmlElement *mass_xml = xml->FirstChildElement("mass");
 		if (mass_xml != nullptr) {
-			if (mass_xml->Attribute("value") != nullptr) {
-				try {
-					i.mass = boost::lexical_cast<double>(mass_xml->Attribute("value"));
-				} catch (boost::bad_lexical_cast &e) {
-					std::ostringstream error_msg;
-					error_msg << "Error while parsing link '" << getParentLinkName(xml)
-							  << "': inertial mass [" << mass_xml->Attribute("value")
-							  << "] is not a valid double: " << e.what() << "!";
-					throw URDFParseError(error_msg.str());
+			const char* mass_str = mass_xml->Attribute("value");
+			if (mass_str != nullptr) {
+				if (!parseDouble(mass_str, i.mass)) {
+					errors.report(mass_xml, ParseErrorCode::INVALID_NUMBER,
+					              "Error while parsing link '{}': inertial mass [{}] is not a valid double!",
+					              { getParentLinkName(xml), mass_str });
 				}
 			} else {
-				std::ostringstream error_msg;
-				error_msg << "Error while parsing link '" << getParentLinkName(xml)
-						  << "' <mass> element must have a value attribute!";
-				throw URDFParseError(error_msg.str());
+				errors.report(mass_xml, ParseErrorCode::MISSING_ATTRIBUTE,
+				              "Error while parsing link '{}' <mass> element must have a value attribute!",
+				              { getParentLinkName(xml) });
 			}
 		} else {
-			std::ostringstream error_msg;
-			error_msg << "Error while parsing link '" << getParentLinkName(xml)
-					  << "' inertial element must have a <mass> element!";
-			throw URDFParseError(error_msg.str());
+			errors.report(xml, ParseErrorCode::MISSING_ELEMENT,
+			              "Error while parsing link '{}' inertial element must have a <mass> element!",
+			              { getParentLinkName(xml) });
 		}
 
 
 		TiXmlElement *inertia_xml = xml->FirstChildElement("inertia");
 		if (inertia_xml != nullptr) {
-			if (inertia_xml->Attribute("ixx") && inertia_xml->Attribute("ixy") && inertia_xml->Attribute("ixz") &&
-				inertia_xml->Attribute("iyy") && inertia_xml->Attribute("iyz") &&
-				inertia_xml->Attribute("izz")) {
-				try {
-					i.ixx	= boost::lexical_cast<double>(inertia_xml->Attribute("ixx"));
-					i.ixy	= boost::lexical_cast<double>(inertia_xml->Attribute("ixy"));
-					i.ixz	= boost::lexical_cast<double>(inertia_xml->Attribute("ixz"));
-					i.iyy	= boost::lexical_cast<double>(inertia_xml->Attribute("iyy"));
-					i.iyz	= boost::lexical_cast<double>(inertia_xml->Attribute("iyz"));
-					i.izz	= boost::lexical_cast<double>(inertia_xml->Attribute("izz"));
-				} catch (boost::bad_lexical_cast &e) {
-					std::ostringstream error_msg;
-					error_msg << "Error while parsing link '" << getParentLinkName(xml)
-							  << "Inertial: one of the inertia elements is not a valid double:"
-							  << " ixx [" << inertia_xml->Attribute("ixx") << "]"
-							  << " ixy [" << inertia_xml->Attribute("ixy") << "]"
-							  << " ixz [" << inertia_xml->Attribute("ixz") << "]"
-							  << " iyy [" << inertia_xml->Attribute("iyy") << "]"
-							  << " iyz [" << inertia_xml->Attribute("iyz") << "]"
-							  << " izz [" << inertia_xml->Attribute("izz") << "]\n\n"
-							  << e.what();
-					throw URDFParseError(error_msg.str());
+			static const char* const inertia_names[6] = { "ixx", "ixy", "ixz", "iyy", "iyz", "izz" };
+			const char* inertia_str[6];
+			if (inertia_xml->Attributes(inertia_names, inertia_str, 6) == 6) {
+				if (!parseDouble(inertia_str[0], i.ixx) ||
+					!parseDouble(inertia_str[1], i.ixy) ||
+					!parseDouble(inertia_str[2], i.ixz) ||
+					!parseDouble(inertia_str[3], i.iyy) ||
+					!parseDouble(inertia_str[4], i.iyz) ||
+					!parseDouble(inertia_str[5], i.izz)) {
+					errors.report(inertia_xml, ParseErrorCode::INVALID_NUMBER,
+					              "Error while parsing link '{}Inertial: one of the inertia elements is not a valid double:"
+					              " ixx [{}] ixy [{}] ixz [{}] iyy [{}] iyz [{}] izz [{}]",
+					              { getParentLinkName(xml), inertia_str[0], inertia_str[1], inertia_str[2],
+					                inertia_str[3], inertia_str[4], inertia_str[5] });
 				}
 			} else {
-				std::ostringstream error_msg;
-				error_msg << "Error while parsing link '" << getParentLinkName(xml)
-						  << "' <inertia> element must have ixx,ixy,ixz,iyy,iyz,izz attributes!";
-				throw URDFParseError(error_msg.str());
+				errors.report(inertia_xml, ParseErrorCode::MISSING_ATTRIBUTE,
+				              "Error while parsing link '{}' <inertia> element must have ixx,ixy,ixz,iyy,iyz,izz attributes!",
+				              { getParentLinkName(xml) });
 			}
 		} else {
-			std::ostringstream error_msg;
-			error_msg << "Error while parsing link '" << getParentLinkName(xml)
-					  << "' inertial element must have a <inertia> element!";
-			throw URDFParseError(error_msg.str());
+			errors.report(xml, ParseErrorCode::MISSING_ELEMENT,
+			              "Error while parsing link '{}' inertial element must have a <inertia> element!",
+			              { getParentLinkName(xml) });
 		}
 
+		if (errors.count() != num_errors) {
+			return std::nullopt;
+		}
 		return i;
 	}
 
 	std::shared_ptr<Visual> Visual::fromXml(TiXmlElement *xml) {
+		ParseErrors errors(ParseErrors::THROW);
+		return fromXml(xml, errors);
+	}
+
+	std::shared_ptr<Visual> Visual::fromXml(TiXmlElement *xml, ParseErrors& errors) {
 		std::shared_ptr<Visual> vis = std::make_shared<Visual>();
+		size_t num_errors = errors.count();
 
 		TiXmlElement *o = xml->FirstChildElement("origin");
 		if (o != nullptr) {
-			try {
-				vis->origin = Transform::fromXml(o);
-			} catch (URDFParseError& e) {
-				std::ostringstream error_msg;
-				error_msg << "Error while parsing link '" << getParentLinkName(xml)
-						  << "': visual origin is not valid: " << e.what() << "!";
-				throw URDFParseError(error_msg.str());
+			ParseError error;
+			if (!Transform::fromXml(o, vis->origin, error)) {
+				errors.report(o, ParseErrorCode::INVALID_NUMBER,
+				              "Error while parsing link '{}': visual origin is not valid: {cause}!",
+				              { getParentLinkName(xml) }, std::move(error));
 			}
 		}
 
 		TiXmlElement *geom = xml->FirstChildElement("geometry");
 		if (geom != nullptr) {
-			vis->geometry = Geometry::fromXml(geom);
+			auto geometry = Geometry::fromXml(geom, errors);
+			if (geometry != nullptr) {
+				vis->geometry = geometry;
+			}
 		}
 
 		const char *name_char = xml->Attribute("name");
 		if (name_char != nullptr) {
+			AllocationScope strings(AllocationSubsystem::STRINGS);
 			vis->name = name_char;
 		}
 
@@ -175,75 +183,93 @@ namespace urdf{
 		if (mat != nullptr) {
 			if (mat->Attribute("name") != nullptr) {
 				vis->material_name = mat->Attribute("name");
+				auto material = Material::fromXml(mat, true, errors);
+				if (material != nullptr) {
+					vis->material = material;
+				}
 			} else {
-				std::ostringstream error_msg;
-				error_msg << "Error while parsing link '" << getParentLinkName(xml)
-						  << "': visual material must contain a name attribute!";
-				throw URDFParseError(error_msg.str());
+				errors.report(mat, ParseErrorCode::MISSING_ATTRIBUTE,
+				              "Error while parsing link '{}': visual material must contain a name attribute!",
+				              { getParentLinkName(xml) });
 			}
-
-			vis->material = Material::fromXml(mat, true);
 		}
 
-		return vis;
+		return errors.count() == num_errors ? vis : nullptr;
 	}
 
 	std::shared_ptr<Collision> Collision::fromXml(TiXmlElement* xml) {
+		ParseErrors errors(ParseErrors::THROW);
+		return fromXml(xml, errors);
+	}
+
+	std::shared_ptr<Collision> Collision::fromXml(TiXmlElement* xml, ParseErrors& errors) {
 		std::shared_ptr<Collision> col = std::make_shared<Collision>();
+		size_t num_errors = errors.count();
 
 		TiXmlElement *o = xml->FirstChildElement("origin");
 		if (o != nullptr) {
-			try {
-				col->origin = Transform::fromXml(o);
-			} catch (URDFParseError& e) {
-				std::ostringstream error_msg;
-				error_msg << "Error while parsing link '" << getParentLinkName(xml)
-						  << "': collision origin is not a valid: " << e.what() << "!";
-				throw URDFParseError(error_msg.str());
+			ParseError error;
+			if (!Transform::fromXml(o, col->origin, error)) {
+				errors.report(o, ParseErrorCode::INVALID_NUMBER,
+				              "Error while parsing link '{}': collision origin is not a valid: {cause}!",
+				              { getParentLinkName(xml) }, std::move(error));
 			}
 		}
 
 		TiXmlElement *geom = xml->FirstChildElement("geometry");
 		if (geom != nullptr){
-			col->geometry = Geometry::fromXml(geom);
+			auto geometry = Geometry::fromXml(geom, errors);
+			if (geometry != nullptr) {
+				col->geometry = geometry;
+			}
 		}
 
 		const char *name_char = xml->Attribute("name");
 		if (name_char != nullptr) {
+			AllocationScope strings(AllocationSubsystem::STRINGS);
 			col->name = name_char;
 		}
 
-		return col;
+		return errors.count() == num_errors ? col : nullptr;
 	}
 
 	std::shared_ptr<Link> Link::fromXml(TiXmlElement* xml) {
+		ParseErrors errors(ParseErrors::THROW);
+		return fromXml(xml, errors);
+	}
+
+	std::shared_ptr<Link> Link::fromXml(TiXmlElement* xml, ParseErrors& errors) {
 		std::shared_ptr<Link> link = std::make_shared<Link>();
+		size_t num_errors = errors.count();
 
 		const char *name_char = xml->Attribute("name");
 		if (name_char != nullptr) {
-			link->name = std::string(name_char);
+			link->name = name_char;
 		} else {
-			std::ostringstream error_msg;
-			error_msg << "Error! Link without a name attribute detected!";
-			throw URDFParseError(error_msg.str());
+			errors.report(xml, ParseErrorCode::MISSING_ATTRIBUTE,
+			              "Error! Link without a name attribute detected!");
 		}
 
 		TiXmlElement *i = xml->FirstChildElement("inertial");
 		if (i != nullptr) {
-			link->inertial = Inertial::fromXml(i);
+			link->inertial = Inertial::fromXml(i, errors);
 		}
 
 		for (TiXmlElement* vis_xml = xml->FirstChildElement("visual"); vis_xml != nullptr; vis_xml = vis_xml->NextSiblingElement("visual")) {
-			auto vis = Visual::fromXml(vis_xml);
-			link->visuals.push_back(vis);
+			auto vis = Visual::fromXml(vis_xml, errors);
+			if (vis != nullptr) {
+				link->visuals.push_back(vis);
+			}
 		}
 
 		for (TiXmlElement* col_xml = xml->FirstChildElement("collision"); col_xml != nullptr; col_xml = col_xml->NextSiblingElement("collision")) {
-			auto col = Collision::fromXml(col_xml);
-			link->collisions.push_back(col);
+			auto col = Collision::fromXml(col_xml, errors);
+			if (col != nullptr) {
+				link->collisions.push_back(col);
+			}
 		}
 
-		return link;
+		return errors.count() == num_errors ? link : nullptr;
 	}
 
 }
@@ -0,0 +1,250 @@
+#include "urdf/loader.h"
+#include "urdf/hash.h"
+#include "urdf/mapped_file.h"
+
+#include "parallel.h"
+#include "work_stealing_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iterator>
+
+using namespace urdf;
+
+struct UrdfLoader::Request {
+	size_t index;               // request number, orders the timings
+	LoadTiming timing;
+	std::string path;           // empty for strings
+	std::string xml_string;
+	std::chrono::steady_clock::time_point requested;
+	bool frozen;                // fulfills frozen_promise instead of promise
+	std::promise<std::shared_ptr<UrdfModel>> promise;
+	std::promise<std::shared_ptr<const FrozenModel>> frozen_promise;
+
+	Request() : index(0), frozen(false) {}
+};
+
+UrdfLoader::UrdfLoader(const LoaderOptions& options) : options(options), num_requests(0), num_strings(0), material_tables_sweep(64) {
+	// the pool already keeps every core busy with documents
+	this->options.parse.num_threads = 1;
+	pool.reset(new WorkStealingPool(resolveThreadCount(options.num_threads)));
+}
+
+UrdfLoader::~UrdfLoader() {
+	pool.reset();
+}
+
+size_t UrdfLoader::numThreads() const {
+	return pool->size();
+}
+
+std::future<std::shared_ptr<UrdfModel>> UrdfLoader::loadFile(const std::string& path) {
+	std::shared_ptr<Request> request = std::make_shared<Request>();
+	request->path = path;
+	std::future<std::shared_ptr<UrdfModel>> model = request->promise.get_future();
+	submit(request);
+	return model;
+}
+
+std::future<std::shared_ptr<UrdfModel>> UrdfLoader::loadString(std::string xml_string) {
+	std::shared_ptr<Request> request = std::make_shared<Request>();
+	request->xml_string = std::move(xml_string);
+	std::future<std::shared_ptr<UrdfModel>> model = request->promise.get_future();
+	submit(request);
+	return model;
+}
+
+std::vector<std::future<std::shared_ptr<UrdfModel>>> UrdfLoader::loadFiles(const std::vector<std::string>& paths) {
+	std::vector<std::future<std::shared_ptr<UrdfModel>>> models;
+	models.reserve(paths.size());
+	for (const auto& path : paths) {
+		models.push_back(loadFile(path));
+	}
+	return models;
+}
+
+std::vector<std::future<std::shared_ptr<UrdfModel>>> UrdfLoader::loadStrings(const std::vector<std::string>& xml_strings) {
+	std::vector<std::future<std::shared_ptr<UrdfModel>>> models;
+	models.reserve(xml_strings.size());
+	for (const auto& xml_string : xml_strings) {
+		models.push_back(loadString(xml_string));
+	}
+	return models;
+}
+
+std::future<std::shared_ptr<const FrozenModel>> UrdfLoader::loadFrozenFile(const std::string& path) {
+	std::shared_ptr<Request> request = std::make_shared<Request>();
+	request->path = path;
+	request->frozen = true;
+	std::future<std::shared_ptr<const FrozenModel>> model = request->frozen_promise.get_future();
+	submit(request);
+	return model;
+}
+
+std::future<std::shared_ptr<const FrozenModel>> UrdfLoader::loadFrozenString(std::string xml_string) {
+	std::shared_ptr<Request> request = std::make_shared<Request>();
+	request->xml_string = std::move(xml_string);
+	request->frozen = true;
+	std::future<std::shared_ptr<const FrozenModel>> model = request->frozen_promise.get_future();
+	submit(request);
+	return model;
+}
+
+std::vector<std::future<std::shared_ptr<const FrozenModel>>> UrdfLoader::loadFrozenFiles(const std::vector<std::string>& paths) {
+	std::vector<std::future<std::shared_ptr<const FrozenModel>>> models;
+	models.reserve(paths.size());
+	for (const auto& path : paths) {
+		models.push_back(loadFrozenFile(path));
+	}
+	return models;
+}
+
+std::vector<std::future<std::shared_ptr<const FrozenModel>>> UrdfLoader::loadFrozenStrings(const std::vector<std::string>& xml_strings) {
+	std::vector<std::future<std::shared_ptr<const FrozenModel>>> models;
+	models.reserve(xml_strings.size());
+	for (const auto& xml_string : xml_strings) {
+		models.push_back(loadFrozenString(xml_string));
+	}
+	return models;
+}
+
+std::vector<LoadTiming> UrdfLoader::timings() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	std::vector<LoadTiming> timings;
+	timings.reserve(finished_timings.size());
+	for (const auto& entry : finished_timings) {
+		timings.push_back(entry.second);
+	}
+	return timings;
+}
+
+std::vector<LoadTiming> UrdfLoader::takeTimings() {
+	std::lock_guard<std::mutex> lock(mutex);
+	std::vector<LoadTiming> timings;
+	timings.reserve(finished_timings.size());
+	for (auto& entry : finished_timings) {
+		timings.push_back(std::move(entry.second));
+	}
+	finished_timings.clear();
+	return timings;
+}
+
+void UrdfLoader::submit(std::shared_ptr<Request> request) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		request->index = num_requests++;
+		request->timing.source = request->path.empty() ? "string " + std::to_string(num_strings++) : request->path;
+	}
+
+	request->requested = std::chrono::steady_clock::now();
+	pool->submit([this, request]() {
+		auto start = std::chrono::steady_clock::now();
+		size_t bytes = request->xml_string.size();
+		std::shared_ptr<UrdfModel> model;
+		std::shared_ptr<const FrozenModel> frozen;
+		std::exception_ptr error;
+		try {
+			if (request->path.empty()) {
+				model = UrdfModel::fromUrdfStr(request->xml_string, options.parse);
+				// the document is not needed anymore, free it before the next one is parsed
+				std::string().swap(request->xml_string);
+			} else {
+				MappedFile file(request->path);
+				bytes = file.size();
+				model = UrdfModel::fromUrdfBuffer(file.data(), options.parse);
+			}
+			if (request->frozen) {
+				frozen = freeze(*model);
+				model.reset();
+			}
+		} catch (...) {
+			error = std::current_exception();
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		LoadTiming& timing = request->timing;
+		timing.bytes = bytes;
+		timing.wait_seconds = std::chrono::duration<double>(start - request->requested).count();
+		timing.parse_seconds = std::chrono::duration<double>(end - start).count();
+		timing.succeeded = !error;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			finished_timings[request->index] = std::move(timing);
+		}
+
+		if (request->frozen) {
+			if (error) {
+				request->frozen_promise.set_exception(error);
+			} else {
+				request->frozen_promise.set_value(std::move(frozen));
+			}
+		} else if (error) {
+			request->promise.set_exception(error);
+		} else {
+			request->promise.set_value(std::move(model));
+		}
+	});
+}
+
+static bool sameMaterial(const Material& a, const Material& b) {
+	return a.name == b.name && a.texture_filename == b.texture_filename &&
+	       a.color.r == b.color.r && a.color.g == b.color.g &&
+	       a.color.b == b.color.b && a.color.a == b.color.a;
+}
+
+static bool sameMaterials(const std::vector<Material>& a, const std::vector<Material>& b) {
+	return std::equal(a.begin(), a.end(), b.begin(), b.end(), sameMaterial);
+}
+
+static uint64_t hashMaterials(const std::vector<Material>& materials) {
+	uint64_t hash = materials.size();
+	for (const Material& material : materials) {
+		float color[4] = { material.color.r, material.color.g, material.color.b, material.color.a };
+		hash = hash64(material.name.c_str(), material.name.size(), hash);
+		hash = hash64(material.texture_filename.data(), material.texture_filename.size(), hash);
+		hash = hash64(color, sizeof(color), hash);
+	}
+	return hash;
+}
+
+std::shared_ptr<const FrozenModel> UrdfLoader::freeze(const UrdfModel& model) {
+	std::shared_ptr<FrozenModel> frozen(new FrozenModel(model));
+	if (options.share_materials && !frozen->materials->empty()) {
+		// nobody else has seen the model yet, so its table can still be swapped
+		frozen->materials = shareMaterials(frozen->materials);
+	}
+	return frozen;
+}
+
+std::shared_ptr<const std::vector<Material>> UrdfLoader::shareMaterials(std::shared_ptr<const std::vector<Material>> table) {
+	uint64_t hash = hashMaterials(*table);
+	std::lock_guard<std::mutex> lock(mutex);
+	auto candidates = material_tables.equal_range(hash);
+	for (auto candidate = candidates.first; candidate != candidates.second; candidate++) {
+		std::shared_ptr<const std::vector<Material>> shared = candidate->second.lock();
+		if (shared != nullptr && sameMaterials(*shared, *table)) {
+			return shared;
+		}
+	}
+
+	material_tables.emplace(hash, table);
+	if (material_tables.size() > material_tables_sweep) {
+		for (auto entry = material_tables.begin(); entry != material_tables.end();) {
+			entry = entry->second.expired() ? material_tables.erase(entry) : std::next(entry);
+		}
+		material_tables_sweep = std::max<size_t>(64, 2 * material_tables.size());
+	}
+	return table;
+}
+
+size_t UrdfLoader::numMaterialTables() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	size_t num_tables = 0;
+	for (auto& entry : material_tables) {
+		if (!entry.second.expired()) {
+			num_tables++;
+		}
+	}
+	return num_tables;
+}
@@ -0,0 +1,94 @@
+#include "urdf/mapped_file.h"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#include <fstream>
+#include <sstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace urdf;
+
+static std::string fileError(const std::string& what, const std::string& path) {
+	return "Error! Could not " + what + " file '" + path + "': " + std::strerror(errno);
+}
+
+#ifdef _WIN32
+
+// no mmap here, fall back to reading the file into an owned buffer
+MappedFile::MappedFile(const std::string& path, bool writable)
+	: data_(nullptr), size_(0), writable_(writable), mapping_size_(0) {
+	std::ifstream in(path, std::ios::in | std::ios::binary);
+	if (!in) {
+		throw URDFParseError(fileError("open", path));
+	}
+
+	std::ostringstream contents;
+	contents << in.rdbuf();
+	buffer_ = contents.str();
+
+	data_ = &buffer_[0];
+	size_ = buffer_.size();
+}
+
+MappedFile::~MappedFile() {}
+
+#else
+
+MappedFile::MappedFile(const std::string& path, bool writable)
+	: data_(nullptr), size_(0), writable_(writable), mapping_size_(0) {
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw URDFParseError(fileError("open", path));
+	}
+
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0) {
+		std::string error_msg = fileError("stat", path);
+		close(fd);
+		throw URDFParseError(error_msg);
+	}
+	size_ = static_cast<size_t>(file_stat.st_size);
+
+	// Reserve one page more than the file needs. The kernel zero fills the tail
+	// of the last file page, and if the file ends exactly on a page boundary the
+	// extra anonymous page provides the terminating zero byte.
+	size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	mapping_size_ = (size_ / page_size + 1) * page_size;
+
+	int protection = writable_ ? PROT_READ | PROT_WRITE : PROT_READ;
+	void* base = mmap(nullptr, mapping_size_, protection, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (base == MAP_FAILED) {
+		std::string error_msg = fileError("map", path);
+		close(fd);
+		throw URDFParseError(error_msg);
+	}
+
+	if (size_ > 0) {
+		void* file = mmap(base, size_, protection, MAP_PRIVATE | MAP_FIXED, fd, 0);
+		if (file == MAP_FAILED) {
+			std::string error_msg = fileError("map", path);
+			munmap(base, mapping_size_);
+			close(fd);
+			throw URDFParseError(error_msg);
+		}
+		madvise(file, size_, MADV_SEQUENTIAL);
+	}
+	close(fd);
+
+	data_ = static_cast<char*>(base);
+}
+
+MappedFile::~MappedFile() {
+	if (data_ != nullptr) {
+		munmap(data_, mapping_size_);
+	}
+}
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef URDF_MEMORY_USAGE_H
+#define URDF_MEMORY_USAGE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace urdf {
+
+	/// Heap memory held by a string, nothing if it fits in the string itself.
+	inline size_t heapBytes(const std::string& text) {
+		static const size_t inline_capacity = std::string().capacity();
+		return text.capacity() > inline_capacity ? text.capacity() + 1 : 0;
+	}
+
+	/// Heap memory of the vector's array, not of what its elements point to.
+	template<typename T>
+	size_t heapBytes(const std::vector<T>& values) {
+		return values.capacity() * sizeof(T);
+	}
+
+}
+
+#endif
@@ -1,32 +1,47 @@
 #include "urdf/model.h"
 #include "urdf/link.h"
 #include "urdf/joint.h"
+#include "urdf/mapped_file.h"
+#include "urdf/allocations.h"
+#include "parallel.h"
+#include "phase_clock.h"
 
 #include "tinyxml/txml.h"
 
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <algorithm>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
 using namespace urdf;
 
-std::shared_ptr<Link> UrdfModel::getLink(const string& name) {
-	if (link_map.find(name) == link_map.end()) {
+std::shared_ptr<Link> UrdfModel::getLink(const string& name) const {
+	auto found = link_map.find(name);
+	if (found == link_map.end()) {
 		return nullptr;
 	} else {
-		return link_map.find(name)->second;
+		return found->second;
 	}
 }
 
-std::shared_ptr<Joint> UrdfModel::getJoint(const string& name) {
-	if (joint_map.find(name) == joint_map.end()) {
+std::shared_ptr<Joint> UrdfModel::getJoint(const string& name) const {
+	auto found = joint_map.find(name);
+	if (found == joint_map.end()) {
 		return nullptr;
 	} else {
-		return joint_map.find(name)->second;
+		return found->second;
 	}
 }
 
-std::shared_ptr<Material> UrdfModel::getMaterial(const string& name) {
-	if (material_map.find(name) == material_map.end()) {
+std::shared_ptr<Material> UrdfModel::getMaterial(const string& name) const {
+	auto found = material_map.find(name);
+	if (found == material_map.end()) {
 		return nullptr;
 	} else {
-		return material_map.find(name)->second;
+		return found->second;
 	}
 }
 
@@ -36,38 +51,71 @@ void UrdfModel::getLinks(vector<std::shared_ptr<Link>>& linklist) const {
 	}
 }
 
-void UrdfModel::initLinkTree(map<string, string>& parent_link_tree) {
+// Path of the element a top level material, link or joint came from.
+static std::string elementPath(const char* type, const Name& name) {
+	return std::string("/robot/") + type + "[@name='" + name.str() + "']";
+}
+
+void UrdfModel::initLinkTree(map<Name, Name>& parent_link_tree) {
+	ParseErrors errors(ParseErrors::THROW);
+	initLinkTree(parent_link_tree, errors);
+}
+
+bool UrdfModel::initLinkTree(map<Name, Name>& parent_link_tree, ParseErrors& errors) {
+	AllocationScope maps(AllocationSubsystem::MAPS);
+	// names are interned, so links can be found by the identity of their name,
+	// a binary search over pointers instead of comparing the text on every
+	// level of link_map
+	typedef std::pair<const void*, const std::shared_ptr<Link>*> LinkById;
+	std::vector<LinkById> links_by_id;
+	links_by_id.reserve(link_map.size());
+	for (auto& link : link_map) {
+		links_by_id.emplace_back(link.first.id(), &link.second);
+	}
+	std::sort(links_by_id.begin(), links_by_id.end());
+	auto findLink = [&links_by_id](const Name& name) -> std::shared_ptr<Link> {
+		auto found = std::lower_bound(links_by_id.begin(), links_by_id.end(), LinkById(name.id(), nullptr));
+		return (found == links_by_id.end() || found->first != name.id()) ? nullptr : *found->second;
+	};
+	auto report = [&errors](const Name& joint_name, ParseErrorCode code, const char* format,
+	                        std::initializer_list<std::string_view> args) {
+		ParseError error(code, format, args);
+		error.setElementPath(elementPath("joint", joint_name));
+		errors.report(nullptr, std::move(error));
+	};
+	size_t num_errors = errors.count();
+
 	for (auto joint = joint_map.begin(); joint != joint_map.end(); joint++) {
-		string parent_link_name = joint->second->parent_link_name;
-		string child_link_name = joint->second->child_link_name;
+		const Name& parent_link_name = joint->second->parent_link_name;
+		const Name& child_link_name = joint->second->child_link_name;
 
 		if (parent_link_name.empty()){
-			ostringstream error_msg;
-			error_msg << "Error while constructing model! Joint [" << joint->first
-					  << "] is missing a parent link specification.";
-			throw URDFParseError(error_msg.str());
+			report(joint->first, ParseErrorCode::MISSING_ELEMENT,
+			       "Error while constructing model! Joint [{}] is missing a parent link specification.",
+			       { joint->first });
+			continue;
 		}
 		if (child_link_name.empty()) {
-			ostringstream error_msg;
-			error_msg << "Error while constructing model! Joint [" << joint->first
-					  << "] is missing a child link specification.";
-			throw URDFParseError(error_msg.str());
+			report(joint->first, ParseErrorCode::MISSING_ELEMENT,
+			       "Error while constructing model! Joint [{}] is missing a child link specification.",
+			       { joint->first });
+			continue;
 		}
 
-		auto child_link = getLink(child_link_name);
+		auto child_link = findLink(child_link_name);
 		if (child_link == nullptr) {
-			ostringstream error_msg;
-			error_msg << "Error while constructing model! Child link [" << child_link_name
-					  << "] of joint [" <<  joint->first << "] not found";
-			throw URDFParseError(error_msg.str());
+			report(joint->first, ParseErrorCode::UNKNOWN_LINK,
+			       "Error while constructing model! Child link [{}] of joint [{}] not found",
+			       { child_link_name, joint->first });
+			continue;
 		}
 
-		auto parent_link = getLink(parent_link_name);
+		auto parent_link = findLink(parent_link_name);
 		if (parent_link == nullptr) {
-			ostringstream error_msg;
-			error_msg << "Error while constructing model! Parent link [" << parent_link_name
-					  << "] of joint [" <<  joint->first << "] not found";
-			throw URDFParseError(error_msg.str());
+			report(joint->first, ParseErrorCode::UNKNOWN_LINK,
+			       "Error while constructing model! Parent link [{}] of joint [{}] not found",
+			       { parent_link_name, joint->first });
+			continue;
 		}
 
 		child_link->setParentLink(parent_link);
@@ -79,119 +127,742 @@ void UrdfModel::initLinkTree(map<string, string>& parent_link_tree) {
 		parent_link_tree[child_link->name] = parent_link_name;
 
 	}
+
+	return errors.count() == num_errors;
+}
+
+void UrdfModel::findRoot(const map<Name, Name> &parent_link_tree) {
+	ParseErrors errors(ParseErrors::THROW);
+	findRoot(parent_link_tree, errors);
 }
 
-void UrdfModel::findRoot(const map<string, string> &parent_link_tree) {
+bool UrdfModel::findRoot(const map<Name, Name> &parent_link_tree, ParseErrors& errors) {
+	bool found_single_root = true;
 	for (auto l=link_map.begin(); l!=link_map.end(); l++) {
 		auto parent = parent_link_tree.find(l->first);
 		if (parent == parent_link_tree.end()) {
 			if (root_link == nullptr) {
-				root_link = getLink(l->first);
+				root_link = l->second;
 			} else {
-				ostringstream error_msg;
-				error_msg << "Error! Multiple root links found: (" << root_link->name
-						  << ") and (" + l->first + ")!";
-				throw URDFParseError(error_msg.str());
+				ParseError error(ParseErrorCode::INVALID_TREE, "Error! Multiple root links found: ({}) and ({})!",
+				                 { root_link->name, l->first });
+				error.setElementPath(elementPath("link", l->first));
+				errors.report(nullptr, std::move(error));
+				found_single_root = false;
 			}
 		}
 	}
 	if (root_link == nullptr) {
-		throw URDFParseError("Error! No root link found. The urdf does not contain a valid link tree.");
+		errors.report(nullptr, ParseErrorCode::INVALID_TREE,
+		              "Error! No root link found. The urdf does not contain a valid link tree.");
+		return false;
 	}
+	return found_single_root;
 }
 
-std::shared_ptr<UrdfModel> UrdfModel::fromUrdfStr(const std::string& xml_string) {
-	std::shared_ptr<UrdfModel> model = std::make_shared<UrdfModel>();
+void UrdfModel::cacheOriginMatrices() {
+	for (auto& entry : link_map) {
+		Link& link = *entry.second;
+		if (link.inertial.has_value()) {
+			link.inertial->origin_matrix = Matrix3x4::fromTransform(link.inertial->origin);
+		}
+		for (auto& visual : link.visuals) {
+			visual->origin_matrix = Matrix3x4::fromTransform(visual->origin);
+		}
+		for (auto& collision : link.collisions) {
+			collision->origin_matrix = Matrix3x4::fromTransform(collision->origin);
+		}
+	}
+	for (auto& entry : joint_map) {
+		entry.second->parent_to_joint_matrix = Matrix3x4::fromTransform(entry.second->parent_to_joint_transform);
+	}
+}
 
-	TiXmlDocument xml_doc;
-	xml_doc.Parse(xml_string.c_str());
-	if (xml_doc.Error()) {
-		std::string error_msg = xml_doc.ErrorDesc();
-		xml_doc.ClearError();
-		throw URDFParseError(error_msg);
+void UrdfModel::addMaterial(std::shared_ptr<Material> material) {
+	ParseErrors errors(ParseErrors::THROW);
+	addMaterial(material, errors);
+}
+
+bool UrdfModel::addMaterial(std::shared_ptr<Material> material, ParseErrors& errors) {
+	if (getMaterial(material->name) != nullptr) {
+		ParseError error(ParseErrorCode::DUPLICATE_NAME, "Duplicate materials '{}' found!", { material->name });
+		error.setElementPath(elementPath("material", material->name));
+		errors.report(nullptr, std::move(error));
+		return false;
+	} else {
+		AllocationScope maps(AllocationSubsystem::MAPS);
+		material_map[material->name] = material;
+		return true;
 	}
+}
 
-	//xml_doc.Print();
-	TiXmlElement *robot_xml = xml_doc.RootElement();
-	if (robot_xml == nullptr || robot_xml->ValueStr() != "robot") {
-		std::string error_msg = "Error! Could not find the <robot> element in the xml file";
-		throw URDFParseError(error_msg);
+void UrdfModel::addLink(std::shared_ptr<Link> link) {
+	ParseErrors errors(ParseErrors::THROW);
+	addLink(link, errors);
+}
+
+bool UrdfModel::addLink(std::shared_ptr<Link> link, ParseErrors& errors) {
+	if (getLink(link->name) != nullptr) {
+		ParseError error(ParseErrorCode::DUPLICATE_NAME, "Error! Duplicate links '{}' found!", { link->name });
+		error.setElementPath(elementPath("link", link->name));
+		errors.report(nullptr, std::move(error));
+		return false;
+	} else {
+		// loop over link visual to find the materials
+		size_t num_errors = errors.count();
+		if (!link->visuals.empty()) {
+			for ( auto visual : link->visuals ) {
+				if (!visual->material_name.empty()) {
+					std::shared_ptr<Material> material = getMaterial(visual->material_name);
+					if (material != nullptr) {
+						visual->material.emplace(material);
+					} else {
+						// if no model matrial found use the one defined in the visual
+						if (visual->material.has_value()) {
+							AllocationScope maps(AllocationSubsystem::MAPS);
+							material_map[visual->material_name] = visual->material.value();
+						} else {
+							// no matrial information available for this visual -> error
+							ParseError error(ParseErrorCode::UNDEFINED_MATERIAL, "Error! Link '{}' material '{} ' undefined!",
+							                 { link->name, visual->material_name });
+							error.setElementPath(elementPath("link", link->name));
+							errors.report(nullptr, std::move(error));
+						}
+					}
+				}
+			}
+		}
+		if (errors.count() != num_errors) {
+			return false;
+		}
+		AllocationScope maps(AllocationSubsystem::MAPS);
+		link_map[link->name] = link;
+		return true;
 	}
+}
 
+void UrdfModel::addJoint(std::shared_ptr<Joint> joint) {
+	ParseErrors errors(ParseErrors::THROW);
+	addJoint(joint, errors);
+}
+
+bool UrdfModel::addJoint(std::shared_ptr<Joint> joint, ParseErrors& errors) {
+	if (getJoint(joint->name) != nullptr) {
+		ParseError error(ParseErrorCode::DUPLICATE_NAME, "Error! Duplicate joints '{}' found!", { joint->name });
+		error.setElementPath(elementPath("joint", joint->name));
+		errors.report(nullptr, std::move(error));
+		return false;
+	} else {
+		AllocationScope maps(AllocationSubsystem::MAPS);
+		joint_map[joint->name] = joint;
+		return true;
+	}
+}
+
+static bool readRobotName(const TiXmlElement *robot_xml, UrdfModel &model, ParseErrors &errors) {
 	const char *name = robot_xml->Attribute("name");
 	if (name != nullptr){
-		model->name = std::string(name);
+		AllocationScope strings(AllocationSubsystem::STRINGS);
+		model.name = std::string(name);
+		return true;
 	} else {
-		std::string error_msg = "No name given for the robot. Please add a name attribute to the robot element!";
-		throw URDFParseError(error_msg);
+		errors.report(robot_xml, ParseErrorCode::MISSING_ATTRIBUTE,
+		              "No name given for the robot. Please add a name attribute to the robot element!");
+		return false;
+	}
+}
+
+// Adds the location of the element at 'offset' to an error that has none yet.
+static URDFParseError locatedError(const URDFParseError &error, const TiXmlDocument &xml_doc,
+                                   const char *xml_buffer, int offset) {
+	if (error.byteOffset() >= 0 || offset < 0) {
+		return error;
 	}
+	TiXmlCursor location = xml_doc.LocationOf(xml_buffer, offset);
+	return URDFParseError(error.what(), offset, location.row + 1, location.col + 1);
+}
 
-	for (TiXmlElement* material_xml = robot_xml->FirstChildElement("material"); material_xml != nullptr; material_xml = material_xml->NextSiblingElement("material")) {
-		auto material = Material::fromXml(material_xml, false); // material needs to be fully defined here
-		if (model->getMaterial(material->name) != nullptr) {
-			std::ostringstream error_msg;
-			error_msg << "Duplicate materials '" << material->name << "' found!";
-			throw URDFParseError(error_msg.str());
-		} else {
-			model->material_map[material->name] = material;
+// Gives the errors the model reported since first_error the offset of the
+// element they are about, the model itself does not know where that is.
+static void locateErrors(ParseErrors &errors, size_t first_error, int offset) {
+	std::vector<ParseError> &reported = errors.getErrors();
+	for (size_t i = first_error; i < reported.size(); i++) {
+		if (reported[i].byteOffset() < 0) {
+			reported[i].setLocation(offset, -1, -1);
+		}
+	}
+}
+
+namespace {
+	// Where a top level element started, for documents that are gone once the
+	// model is built.
+	struct ElementOffset {
+		const char* type;
+		Name name;
+		int offset;
+	};
+}
+
+// Same for errors about the link tree, which only know the path of their
+// element. Only runs once the document turned out to be broken, and looks the
+// paths up in a table of the top level elements built on first need.
+static void locateErrors(ParseErrors &errors, size_t first_error, const TiXmlElement *robot_xml,
+                         const std::vector<ElementOffset> &streamed) {
+	std::vector<ParseError> &reported = errors.getErrors();
+	std::unordered_map<std::string, int> offsets;
+	bool indexed = false;
+	for (size_t i = first_error; i < reported.size(); i++) {
+		if (reported[i].byteOffset() >= 0 || reported[i].elementPath().empty()) {
+			continue;
+		}
+		if (!indexed) {
+			indexed = true;
+			// the first of several elements with the same path wins
+			for (const TiXmlElement* element = robot_xml->FirstChildElement(); element != nullptr; element = element->NextSiblingElement()) {
+				ParseError located;
+				located.setElement(element);
+				offsets.emplace(located.elementPath(), located.byteOffset());
+			}
+			for (const ElementOffset &element : streamed) {
+				offsets.emplace(elementPath(element.type, element.name), element.offset);
+			}
+		}
+		auto found = offsets.find(reported[i].elementPath());
+		if (found != offsets.end()) {
+			reported[i].setLocation(found->second, -1, -1);
 		}
 	}
+}
 
-	for (TiXmlElement* link_xml = robot_xml->FirstChildElement("link"); link_xml != nullptr; link_xml = link_xml->NextSiblingElement("link")) {
-    auto link = Link::fromXml(link_xml);
+static size_t countAttributes(const TiXmlElement *element) {
+	size_t count = 0;
+	for (const TiXmlAttribute* attribute = element->FirstAttribute(); attribute != nullptr; attribute = attribute->Next()) {
+		count++;
+	}
+	return count;
+}
 
-		if (model->getLink(link->name) != nullptr) {
-			std::ostringstream error_msg;
-			error_msg << "Error! Duplicate links '" << link->name << "' found!";
-			throw URDFParseError(error_msg.str());
-		} else {
-			// loop over link visual to find the materials
-			if (!link->visuals.empty()) {
-				for ( auto visual : link->visuals ) {
-					if (!visual->material_name.empty()) {
-						if (model->getMaterial(visual->material_name) != nullptr) {
-							visual->material.emplace(model->getMaterial( visual->material_name.c_str() ));
-						} else {
-							// if no model matrial found use the one defined in the visual
-							if (visual->material.has_value()) {
-								model->material_map[visual->material_name] = visual->material.value();
-							} else {
-								// no matrial information available for this visual -> error
-								std::ostringstream error_msg;
-								error_msg << "Error! Link '" << link->name
-										  << "' material '" << visual->material_name
-										  <<" ' undefined!";
-								throw URDFParseError(error_msg.str());
+// Counts the elements and attributes below node for the ParseStats.
+static void countElements(const TiXmlNode *node, PhaseClock &clock) {
+	for (const TiXmlElement* element = node->FirstChildElement(); element != nullptr; element = element->NextSiblingElement()) {
+		clock.count(&ParseStats::elements, 1);
+		clock.count(&ParseStats::attributes, countAttributes(element));
+		countElements(element, clock);
+	}
+}
+
+// Stand in for a link or joint element that could not be converted when all
+// errors are collected, so the link tree is still checked without reporting
+// every joint of a broken link again.
+static std::shared_ptr<Link> placeholderLink(const TiXmlElement *link_xml) {
+	const char *name = link_xml->Attribute("name");
+	if (name == nullptr) {
+		return nullptr;
+	}
+	std::shared_ptr<Link> link = std::make_shared<Link>();
+	link->name = name;
+	return link;
+}
+
+static std::shared_ptr<Joint> placeholderJoint(const TiXmlElement *joint_xml) {
+	const char *name = joint_xml->Attribute("name");
+	if (name == nullptr) {
+		return nullptr;
+	}
+	std::shared_ptr<Joint> joint = std::make_shared<Joint>();
+	joint->name = name;
+	const TiXmlElement *parent_xml = joint_xml->FirstChildElement("parent");
+	if (parent_xml != nullptr && parent_xml->Attribute("link") != nullptr) {
+		joint->parent_link_name = parent_xml->Attribute("link");
+	}
+	const TiXmlElement *child_xml = joint_xml->FirstChildElement("child");
+	if (child_xml != nullptr && child_xml->Attribute("link") != nullptr) {
+		joint->child_link_name = child_xml->Attribute("link");
+	}
+	return joint;
+}
+
+namespace {
+	// Converts the materials, links and joints below <robot> as soon as TinyXML
+	// has closed their element and discards the element again, so the DOM never
+	// holds more than one of them. Links are kept back until the end of the
+	// document, because their visuals may use materials that are defined later.
+	class StreamingUrdfParser : public TiXmlParseListener {
+		public:
+			StreamingUrdfParser(UrdfModel &model, const TiXmlDocument &xml_doc, const char *xml_buffer, ParseErrors &errors,
+			                    ParseStats *stats)
+				: model(model), xml_doc(xml_doc), xml_buffer(xml_buffer), errors(errors), clock(stats), robot_checked(false), conversion_failed(false) {}
+
+			Result ElementParsed(const TiXmlNode* parent, TiXmlElement* element, int depth) override {
+				if (clock.enabled()) {
+					// the element and its attributes are each a heap block, there is no arena
+					size_t num_attributes = countAttributes(element);
+					clock.count(&ParseStats::elements, 1);
+					clock.count(&ParseStats::attributes, num_attributes);
+					clock.count(&ParseStats::allocations, 1 + num_attributes);
+				}
+				if (depth != 2 || parent->ValueStr() != "robot") {
+					return KEEP;
+				}
+				clock.restart();
+				// the conversion runs inside TinyXML, but is not part of the DOM
+				AllocationScope conversion(AllocationSubsystem::OTHER);
+
+				try {
+					if (!robot_checked) {
+						robot_checked = true;
+						try {
+							readRobotName(parent->ToElement(), model, errors);
+						} catch (const URDFParseError &e) {
+							throw locatedError(e, xml_doc, xml_buffer, parent->ByteOffset());
+						}
+					}
+
+					const std::string &type = element->ValueStr();
+					if (type == "material") {
+						auto material = Material::fromXml(element, false, errors); // material needs to be fully defined here
+						size_t first_error = errors.getErrors().size();
+						if (material != nullptr && !model.addMaterial(material, errors)) {
+							locateErrors(errors, first_error, element->ByteOffset());
+						}
+						clock.lap(&ParseStats::material_seconds);
+					} else if (type == "link") {
+						auto link = Link::fromXml(element, errors);
+						conversion_failed = conversion_failed || link == nullptr;
+						if (link == nullptr && !errors.stop()) {
+							link = placeholderLink(element);
+						}
+						if (link != nullptr) {
+							links.push_back(link);
+							link_offsets.push_back(element->ByteOffset());
+							offsets.push_back({ "link", link->name, element->ByteOffset() });
+						}
+						clock.lap(&ParseStats::link_seconds);
+					} else if (type == "joint") {
+						auto joint = Joint::fromXml(element, errors);
+						conversion_failed = conversion_failed || joint == nullptr;
+						if (joint == nullptr && !errors.stop()) {
+							joint = placeholderJoint(element);
+						}
+						size_t first_error = errors.getErrors().size();
+						if (joint != nullptr) {
+							offsets.push_back({ "joint", joint->name, element->ByteOffset() });
+							if (!model.addJoint(joint, errors)) {
+								locateErrors(errors, first_error, element->ByteOffset());
 							}
 						}
+						clock.lap(&ParseStats::joint_seconds);
+					} else {
+						return KEEP;
+					}
+				} catch (const URDFParseError &e) {
+					error = std::make_exception_ptr(locatedError(e, xml_doc, xml_buffer, element->ByteOffset()));
+					return STOP;
+				} catch (...) {
+					error = std::current_exception();
+					return STOP;
+				}
+
+				return errors.stop() ? STOP : DISCARD;
+			}
+
+			UrdfModel &model;
+			const TiXmlDocument &xml_doc;
+			const char *xml_buffer;
+			ParseErrors &errors;
+			// books the conversions, they happen while TinyXML reads the document
+			PhaseClock clock;
+			bool robot_checked;
+			// a link or joint element could not be converted
+			bool conversion_failed;
+			std::vector<std::shared_ptr<Link>> links;
+			std::vector<int> link_offsets;
+			// of the links and joints, to locate errors about the link tree
+			std::vector<ElementOffset> offsets;
+			std::exception_ptr error;
+	};
+}
+
+namespace {
+	// Converts all links and joints below <robot> ahead of time on a pool of
+	// threads. Each element only reads its own subtree of the finished DOM, so
+	// the conversions are independent. The errors of an element are kept with
+	// it and thrown or reported when the element is taken, so adding them to
+	// the model in document order gives the same errors as converting them one
+	// by one.
+	class ParallelElementConverter {
+		public:
+			ParallelElementConverter(TiXmlElement *robot_xml, unsigned int num_threads, ParseErrors::Mode mode) {
+				std::vector<TiXmlElement*> link_elements;
+				for (TiXmlElement* link_xml = robot_xml->FirstChildElement("link"); link_xml != nullptr; link_xml = link_xml->NextSiblingElement("link")) {
+					link_elements.push_back(link_xml);
+				}
+				std::vector<TiXmlElement*> joint_elements;
+				for (TiXmlElement* joint_xml = robot_xml->FirstChildElement("joint"); joint_xml != nullptr; joint_xml = joint_xml->NextSiblingElement("joint")) {
+					joint_elements.push_back(joint_xml);
+				}
+
+				size_t num_links = link_elements.size();
+				links.resize(num_links);
+				joints.resize(joint_elements.size());
+				exceptions.resize(num_links + joint_elements.size());
+				errors.resize(num_links + joint_elements.size());
+
+				parallelFor(errors.size(), num_threads, 32, [&](size_t i) {
+					try {
+						ParseErrors element_errors(mode);
+						if (i < num_links) {
+							links[i] = Link::fromXml(link_elements[i], element_errors);
+						} else {
+							joints[i - num_links] = Joint::fromXml(joint_elements[i - num_links], element_errors);
+						}
+						errors[i] = std::move(element_errors.getErrors());
+					} catch (...) {
+						exceptions[i] = std::current_exception();
 					}
+				});
+			}
+
+			std::shared_ptr<Link> link(size_t i, ParseErrors &errors) const {
+				take(i, errors);
+				return links[i];
+			}
+
+			std::shared_ptr<Joint> joint(size_t i, ParseErrors &errors) const {
+				take(links.size() + i, errors);
+				return joints[i];
+			}
+
+		private:
+			void take(size_t i, ParseErrors &errors) const {
+				if (exceptions[i]) {
+					std::rethrow_exception(exceptions[i]);
+				}
+				for (const ParseError &error : this->errors[i]) {
+					errors.report(nullptr, error);
 				}
 			}
-			model->link_map[link->name] = link;
+
+			std::vector<std::shared_ptr<Link>> links;
+			std::vector<std::shared_ptr<Joint>> joints;
+			std::vector<std::exception_ptr> exceptions;
+			std::vector<std::vector<ParseError>> errors;
+	};
+}
+
+// Builds the model from the document in xml_buffer. Errors are reported to
+// errors, in THROW mode the exceptions get the location of the top level
+// element they are about. Returns false if the document is broken. The
+// document is parsed in place if in_situ_buffer, the same buffer, is given,
+// otherwise it is only read and the attribute values are copied.
+static bool buildModel(UrdfModel &model, TiXmlDocument &xml_doc, const char *xml_buffer, char *in_situ_buffer,
+                       const ParseOptions &options, ParseErrors &errors, PhaseClock &clock) {
+	StreamingUrdfParser streaming_parser(model, xml_doc, xml_buffer, errors, clock.get());
+	if (!options.track_locations) {
+		xml_doc.SetTabSize(0);
+	}
+	if (options.streaming) {
+		xml_doc.SetParseListener(&streaming_parser);
+	} else {
+		// the DOM only lives until the model is built, so it can be allocated from
+		// an arena. Not when streaming, discarded elements would not free memory.
+		xml_doc.SetUseArena(true);
+	}
+
+	clock.restart();
+	{
+		AllocationScope dom(AllocationSubsystem::XML_DOM);
+		if (in_situ_buffer != nullptr) {
+			xml_doc.ParseInSitu(in_situ_buffer);
+		} else {
+			xml_doc.Parse(xml_buffer);
+		}
+	}
+	clock.lap(&ParseStats::xml_seconds);
+	if (ParseStats *stats = clock.get()) {
+		if (options.streaming) {
+			stats->xml_seconds -= stats->material_seconds + stats->link_seconds + stats->joint_seconds;
+		} else {
+			countElements(&xml_doc, clock);
+			clock.count(&ParseStats::allocations, xml_doc.Arena()->BlockCount());
+			clock.restart();
+		}
+	}
+	if (streaming_parser.error) {
+		std::rethrow_exception(streaming_parser.error);
+	}
+	if (errors.stop()) {
+		return false;
+	}
+	if (xml_doc.Error()) {
+		ParseError error(ParseErrorCode::XML_SYNTAX, "{}", { xml_doc.ErrorDesc() });
+		if (xml_doc.ErrorOffset() >= 0) {
+			error.setLocation(xml_doc.ErrorOffset(), xml_doc.ErrorRow(), xml_doc.ErrorCol());
 		}
+		errors.report(nullptr, std::move(error));
+		return false;
+	}
+
+	//xml_doc.Print();
+	TiXmlElement *robot_xml = xml_doc.RootElement();
+	if (robot_xml == nullptr || robot_xml->ValueStr() != "robot") {
+		errors.report(nullptr, ParseErrorCode::MISSING_ELEMENT,
+		              "Error! Could not find the <robot> element in the xml file");
+		return false;
 	}
 
-	if (model->link_map.size() == 0){
-		std::string error_msg = "Error! No link elements found in the urdf file.";
-		throw URDFParseError(error_msg);
+	try {
+		if (!readRobotName(robot_xml, model, errors) && errors.stop()) {
+			return false;
+		}
+	} catch (const URDFParseError &e) {
+		throw locatedError(e, xml_doc, xml_buffer, robot_xml->ByteOffset());
 	}
 
-	for (TiXmlElement* joint_xml = robot_xml->FirstChildElement("joint"); joint_xml != nullptr; joint_xml = joint_xml->NextSiblingElement("joint")) {
-		auto joint = Joint::fromXml(joint_xml);
+	bool conversion_failed = streaming_parser.conversion_failed;
+	if (options.streaming) {
+		for (size_t i = 0; i < streaming_parser.links.size(); i++) {
+			try {
+				size_t first_error = errors.getErrors().size();
+				if (!model.addLink(streaming_parser.links[i], errors)) {
+					locateErrors(errors, first_error, streaming_parser.link_offsets[i]);
+				}
+				if (errors.stop()) {
+					return false;
+				}
+			} catch (const URDFParseError &e) {
+				throw locatedError(e, xml_doc, xml_buffer, streaming_parser.link_offsets[i]);
+			}
+		}
 
-		if (model->getJoint(joint->name) != nullptr) {
-			std::ostringstream error_msg;
-			error_msg << "Error! Duplicate joints '" << joint->name << "' found!";
-			throw URDFParseError(error_msg.str());
-		} else {
-			model->joint_map[joint->name] = joint;
+		if (model.link_map.size() == 0){
+			errors.report(robot_xml, ParseErrorCode::MISSING_ELEMENT,
+			              "Error! No link elements found in the urdf file.");
+			return false;
+		}
+	} else {
+		std::unique_ptr<ParallelElementConverter> converted;
+		if (resolveThreadCount(options.num_threads) > 1) {
+			clock.restart();
+			converted.reset(new ParallelElementConverter(robot_xml, options.num_threads, errors.getMode()));
+			clock.lap(&ParseStats::link_seconds);
+		}
+
+		clock.restart();
+		for (TiXmlElement* material_xml = robot_xml->FirstChildElement("material"); material_xml != nullptr; material_xml = material_xml->NextSiblingElement("material")) {
+			try {
+				auto material = Material::fromXml(material_xml, false, errors); // material needs to be fully defined here
+				size_t first_error = errors.getErrors().size();
+				if (material != nullptr && !model.addMaterial(material, errors)) {
+					locateErrors(errors, first_error, material_xml->ByteOffset());
+				}
+				if (errors.stop()) {
+					return false;
+				}
+			} catch (const URDFParseError &e) {
+				throw locatedError(e, xml_doc, xml_buffer, material_xml->ByteOffset());
+			}
+		}
+
+		clock.lap(&ParseStats::material_seconds);
+
+		size_t link_index = 0;
+		for (TiXmlElement* link_xml = robot_xml->FirstChildElement("link"); link_xml != nullptr; link_xml = link_xml->NextSiblingElement("link")) {
+			try {
+				auto link = converted ? converted->link(link_index++, errors) : Link::fromXml(link_xml, errors);
+				conversion_failed = conversion_failed || link == nullptr;
+				if (link == nullptr && !errors.stop()) {
+					link = placeholderLink(link_xml);
+				}
+				clock.lap(&ParseStats::link_seconds);
+				size_t first_error = errors.getErrors().size();
+				if (link != nullptr && !model.addLink(link, errors)) {
+					locateErrors(errors, first_error, link_xml->ByteOffset());
+				}
+				clock.lap(&ParseStats::material_resolution_seconds);
+				if (errors.stop()) {
+					return false;
+				}
+			} catch (const URDFParseError &e) {
+				throw locatedError(e, xml_doc, xml_buffer, link_xml->ByteOffset());
+			}
+		}
+
+		if (model.link_map.size() == 0){
+			errors.report(robot_xml, ParseErrorCode::MISSING_ELEMENT,
+			              "Error! No link elements found in the urdf file.");
+			return false;
 		}
+
+		clock.restart();
+		size_t joint_index = 0;
+		for (TiXmlElement* joint_xml = robot_xml->FirstChildElement("joint"); joint_xml != nullptr; joint_xml = joint_xml->NextSiblingElement("joint")) {
+			try {
+				auto joint = converted ? converted->joint(joint_index++, errors) : Joint::fromXml(joint_xml, errors);
+				conversion_failed = conversion_failed || joint == nullptr;
+				if (joint == nullptr && !errors.stop()) {
+					joint = placeholderJoint(joint_xml);
+				}
+				size_t first_error = errors.getErrors().size();
+				if (joint != nullptr && !model.addJoint(joint, errors)) {
+					locateErrors(errors, first_error, joint_xml->ByteOffset());
+				}
+				if (errors.stop()) {
+					return false;
+				}
+			} catch (const URDFParseError &e) {
+				throw locatedError(e, xml_doc, xml_buffer, joint_xml->ByteOffset());
+			}
+		}
+		clock.lap(&ParseStats::joint_seconds);
 	}
 
-	std::map<std::string, std::string> parent_link_tree;
+	std::map<Name, Name> parent_link_tree;
 
-	model->initLinkTree(parent_link_tree);
-	model->findRoot(parent_link_tree);
+	// no roots are looked for in a link tree with holes, they would not be real
+	// ones, and neither if a link or joint is missing or only a placeholder
+	size_t first_error = errors.getErrors().size();
+	clock.restart();
+	bool linked = model.initLinkTree(parent_link_tree, errors) &&
+	              (conversion_failed || model.findRoot(parent_link_tree, errors));
+	clock.lap(&ParseStats::link_tree_seconds);
+	if (!linked) {
+		locateErrors(errors, first_error, robot_xml, streaming_parser.offsets);
+		return false;
+	}
+
+	if (errors.failed()) {
+		return false;
+	}
+
+	if (options.cache_origin_matrices) {
+		model.cacheOriginMatrices();
+		clock.lap(&ParseStats::origin_matrix_seconds);
+	}
+
+	clock.count(&ParseStats::materials, model.material_map.size());
+	clock.count(&ParseStats::links, model.link_map.size());
+	clock.count(&ParseStats::joints, model.joint_map.size());
+	return true;
+}
 
+// Runs buildModel() and counts the line and column of the errors that are
+// kept, nullptr if the document is broken.
+static std::shared_ptr<UrdfModel> parseUrdf(const char* xml_buffer, char* in_situ_buffer, const ParseOptions& options,
+                                            ParseErrors& errors, ParseStats* stats = nullptr) {
+	if (stats != nullptr && ParseStats::enabled) {
+		stats->clear();
+	}
+	PhaseClock clock(stats);
+	PhaseClock total_clock(stats);
+	if (clock.enabled()) {
+		clock.count(&ParseStats::bytes, std::strlen(xml_buffer));
+	}
+
+	std::shared_ptr<UrdfModel> model = std::make_shared<UrdfModel>();
+	TiXmlDocument xml_doc;
+	bool built = buildModel(*model, xml_doc, xml_buffer, in_situ_buffer, options, errors, clock);
+	total_clock.lap(&ParseStats::total_seconds);
+
+	for (ParseError& error : errors.getErrors()) {
+		if (error.line() < 0 && error.byteOffset() >= 0) {
+			TiXmlCursor location = xml_doc.LocationOf(xml_buffer, error.byteOffset());
+			error.setLocation(error.byteOffset(), location.row + 1, location.col + 1);
+		}
+	}
+	return built ? model : nullptr;
+}
+
+// The tryFrom*() functions, the buffer is parsed in place if in_situ_buffer is given.
+static ParseResult<std::shared_ptr<UrdfModel>> tryParseUrdf(const char* xml_buffer, char* in_situ_buffer,
+                                                            const ParseOptions& options) {
+	ParseErrors errors(ParseErrors::FIRST);
+	std::shared_ptr<UrdfModel> model = parseUrdf(xml_buffer, in_situ_buffer, options, errors);
+	if (model == nullptr) {
+		return errors.getErrors().front();
+	}
 	return model;
 }
+
+// The validate*() functions, the buffer is parsed in place if in_situ_buffer is given.
+static std::vector<ParseError> validateUrdf(const char* xml_buffer, char* in_situ_buffer, const ParseOptions& options) {
+	ParseErrors errors(ParseErrors::ALL);
+	parseUrdf(xml_buffer, in_situ_buffer, options, errors);
+
+	std::vector<ParseError> found = std::move(errors.getErrors());
+	// the model level checks run after all elements are converted
+	std::stable_sort(found.begin(), found.end(), [](const ParseError& a, const ParseError& b) {
+		if (a.byteOffset() < 0 || b.byteOffset() < 0) {
+			return b.byteOffset() < 0 && a.byteOffset() >= 0;
+		}
+		return a.byteOffset() < b.byteOffset();
+	});
+	return found;
+}
+
+std::shared_ptr<UrdfModel> UrdfModel::fromUrdfStr(const std::string& xml_string, const ParseOptions& options,
+                                                  ParseStats* stats) {
+	const char* xml = xml_string.c_str();
+	std::vector<char> buffer(xml, xml + xml_string.size() + 1);
+	return fromUrdfBufferInSitu(buffer.data(), options, stats);
+}
+
+std::shared_ptr<UrdfModel> UrdfModel::fromUrdfFile(const std::string& path, const ParseOptions& options,
+                                                   ParseStats* stats) {
+	// read only, parsing in place would copy every page it writes a terminator to
+	MappedFile file(path);
+	ParseErrors errors(ParseErrors::THROW);
+	return parseUrdf(file.data(), nullptr, options, errors, stats);
+}
+
+std::shared_ptr<UrdfModel> UrdfModel::fromUrdfBuffer(const char* xml_buffer, const ParseOptions& options,
+                                                     ParseStats* stats) {
+	ParseErrors errors(ParseErrors::THROW);
+	return parseUrdf(xml_buffer, nullptr, options, errors, stats);
+}
+
+std::shared_ptr<UrdfModel> UrdfModel::fromUrdfBufferInSitu(char* xml_buffer, const ParseOptions& options,
+                                                           ParseStats* stats) {
+	ParseErrors errors(ParseErrors::THROW);
+	return parseUrdf(xml_buffer, xml_buffer, options, errors, stats);
+}
+
+ParseResult<std::shared_ptr<UrdfModel>> UrdfModel::tryFromUrdfStr(const std::string& xml_string, const ParseOptions& options) {
+	const char* xml = xml_string.c_str();
+	std::vector<char> buffer(xml, xml + xml_string.size() + 1);
+	return tryFromUrdfBufferInSitu(buffer.data(), options);
+}
+
+ParseResult<std::shared_ptr<UrdfModel>> UrdfModel::tryFromUrdfFile(const std::string& path, const ParseOptions& options) {
+	std::unique_ptr<MappedFile> file;
+	try {
+		file.reset(new MappedFile(path));
+	} catch (const URDFParseError &e) {
+		return ParseError(ParseErrorCode::FILE_ERROR, "{}", { e.what() });
+	}
+	return tryParseUrdf(file->data(), nullptr, options);
+}
+
+ParseResult<std::shared_ptr<UrdfModel>> UrdfModel::tryFromUrdfBufferInSitu(char* xml_buffer, const ParseOptions& options) {
+	return tryParseUrdf(xml_buffer, xml_buffer, options);
+}
+
+std::vector<ParseError> UrdfModel::validateUrdfStr(const std::string& xml_string, const ParseOptions& options) {
+	const char* xml = xml_string.c_str();
+	std::vector<char> buffer(xml, xml + xml_string.size() + 1);
+	return validateUrdfBufferInSitu(buffer.data(), options);
+}
+
+std::vector<ParseError> UrdfModel::validateUrdfFile(const std::string& path, const ParseOptions& options) {
+	std::unique_ptr<MappedFile> file;
+	try {
+		file.reset(new MappedFile(path));
+	} catch (const URDFParseError &e) {
+		return { ParseError(ParseErrorCode::FILE_ERROR, "{}", { e.what() }) };
+	}
+	return validateUrdf(file->data(), nullptr, options);
+}
+
+std::vector<ParseError> UrdfModel::validateUrdfBufferInSitu(char* xml_buffer, const ParseOptions& options) {
+	return validateUrdf(xml_buffer, xml_buffer, options);
+}
@@ -0,0 +1,784 @@
+// Binary form of a UrdfModel (.urdfbin).
+//
+// The file is a fixed header followed by tables of fixed size records, so a
+// mapped file can be read record by record without any text parsing. All
+// integers and doubles are little endian, all records are 8 byte aligned.
+//
+//   header      128 bytes
+//     0   char[8]  magic "URDFBIN\0"
+//     8   u32      format version
+//     12  u32      header size
+//     16  u64      hash of the URDF text the model was parsed from
+//     24  u64      hash of everything after the header
+//     32  u64      total file size
+//     40  string   robot name
+//     48  i32      root link, -1 if none
+//     52  u32      flags, ORIGIN_MATRICES if the model had cached origin matrices
+//     56  table[8] u32 offset, u32 count of materials, geometries, visuals,
+//                  collisions, links, joints, children and the string bytes
+//
+//   string      u32 offset, u32 length into the string bytes, which hold every
+//               string followed by a zero byte
+//   transform   f64 position x y z, f64 rotation quaternion x y z w
+//
+// Record layouts are given next to their sizes below. Indices refer to other
+// tables and are -1 for an empty optional.
+
+#include "urdf/model.h"
+#include "urdf/hash.h"
+#include "urdf/mapped_file.h"
+
+#include <cstring>
+#include <sstream>
+#include <unordered_map>
+
+using namespace urdf;
+
+namespace {
+	const char BINARY_MAGIC[8] = { 'U', 'R', 'D', 'F', 'B', 'I', 'N', '\0' };
+	const uint32_t BINARY_VERSION = 1;
+
+	const size_t HEADER_SIZE = 128;
+	const size_t HEADER_TABLES = 56;
+
+	enum Table {
+		MATERIALS, GEOMETRIES, VISUALS, COLLISIONS, LINKS, JOINTS, CHILDREN, STRINGS,
+		NUM_TABLES
+	};
+
+	// f32 r g b a, string name, string texture_filename, u32 flags, u32 reserved
+	const size_t MATERIAL_SIZE = 40;
+	// u32 type, u32 reserved, f64 parameters[3], string filename
+	//   sphere: radius; box: size x y z; cylinder, capsule: length radius; mesh: scale x y z
+	const size_t GEOMETRY_SIZE = 40;
+	// transform origin, string name, string material_name, i32 geometry, i32 material
+	const size_t VISUAL_SIZE = 80;
+	// transform origin, string name, i32 geometry, u32 reserved
+	const size_t COLLISION_SIZE = 72;
+	// transform inertial origin, f64 mass ixx ixy ixz iyy iyz izz, string name,
+	// u32 flags, i32 parent_link, i32 parent_joint, u32 first_visual,
+	// u32 num_visuals, u32 first_collision, u32 num_collisions, u32 first_child,
+	// u32 num_children, u32 reserved
+	const size_t LINK_SIZE = 160;
+	// transform origin, f64 axis x y z, f64 limits lower upper effort velocity,
+	// f64 safety upper_limit lower_limit k_position k_velocity, f64 dynamics
+	// damping friction, f64 calibration rising falling, f64 mimic offset
+	// multiplier, string name parent child mimic_joint, u32 type, u32 flags
+	const size_t JOINT_SIZE = 232;
+	// u32 joint, u32 link
+	const size_t CHILD_SIZE = 8;
+
+	// the matrices follow from the origins, so only the fact that they were cached is stored
+	const uint32_t ORIGIN_MATRICES = 1;
+
+	const uint32_t MATERIAL_IN_MAP = 1;
+	const uint32_t LINK_HAS_INERTIAL = 1;
+
+	enum JointFlags {
+		JOINT_DYNAMICS = 1,
+		JOINT_LIMITS = 2,
+		JOINT_SAFETY = 4,
+		JOINT_CALIBRATION = 8,
+		JOINT_CALIBRATION_RISING = 16,
+		JOINT_CALIBRATION_FALLING = 32,
+		JOINT_MIMIC = 64
+	};
+
+	// Strings of all tables, each one stored once and followed by a zero byte.
+	class StringTable {
+		public:
+			std::string bytes;
+
+			// offset and length of value in bytes
+			std::pair<uint32_t, uint32_t> add(const std::string& value) {
+				auto existing = offsets.find(value);
+				if (existing != offsets.end()) {
+					return std::make_pair(existing->second, (uint32_t) value.size());
+				}
+				uint32_t offset = static_cast<uint32_t>(bytes.size());
+				bytes.append(value);
+				bytes.push_back('\0');
+				offsets[value] = offset;
+				return std::make_pair(offset, (uint32_t) value.size());
+			}
+
+		private:
+			std::unordered_map<std::string, uint32_t> offsets;
+	};
+
+	// Appends the little endian fields of the records of one table.
+	class RecordWriter {
+		public:
+			std::string data;
+			uint32_t count;
+
+			RecordWriter() : count(0), strings(nullptr) {}
+
+			void setStrings(StringTable* table) {
+				strings = table;
+			}
+
+			void u32(uint32_t value) {
+				for (int i = 0; i < 4; i++) {
+					data.push_back(static_cast<char>(value >> (8 * i)));
+				}
+			}
+
+			void i32(int32_t value) {
+				u32(static_cast<uint32_t>(value));
+			}
+
+			void u64(uint64_t value) {
+				for (int i = 0; i < 8; i++) {
+					data.push_back(static_cast<char>(value >> (8 * i)));
+				}
+			}
+
+			void f32(float value) {
+				uint32_t bits;
+				std::memcpy(&bits, &value, sizeof(bits));
+				u32(bits);
+			}
+
+			void f64(double value) {
+				uint64_t bits;
+				std::memcpy(&bits, &value, sizeof(bits));
+				u64(bits);
+			}
+
+			void string(const std::string& value) {
+				std::pair<uint32_t, uint32_t> ref = strings->add(value);
+				u32(ref.first);
+				u32(ref.second);
+			}
+
+			void transform(const Transform& t) {
+				vector3(t.position);
+				f64(t.rotation.x);
+				f64(t.rotation.y);
+				f64(t.rotation.z);
+				f64(t.rotation.w);
+			}
+
+			void vector3(const Vector3& v) {
+				f64(v.x);
+				f64(v.y);
+				f64(v.z);
+			}
+
+		private:
+			StringTable* strings;
+	};
+
+	class BinaryReader {
+		public:
+			BinaryReader(const char* data, size_t size)
+				: data(reinterpret_cast<const unsigned char*>(data)), size(size),
+				  strings(nullptr), strings_size(0) {}
+
+			uint32_t u32(size_t position) const {
+				const unsigned char* p = data + position;
+				return (uint32_t) p[0] | (uint32_t) p[1] << 8 | (uint32_t) p[2] << 16 | (uint32_t) p[3] << 24;
+			}
+
+			int32_t i32(size_t position) const {
+				return static_cast<int32_t>(u32(position));
+			}
+
+			uint64_t u64(size_t position) const {
+				return (uint64_t) u32(position) | (uint64_t) u32(position + 4) << 32;
+			}
+
+			float f32(size_t position) const {
+				uint32_t bits = u32(position);
+				float value;
+				std::memcpy(&value, &bits, sizeof(value));
+				return value;
+			}
+
+			double f64(size_t position) const {
+				uint64_t bits = u64(position);
+				double value;
+				std::memcpy(&value, &bits, sizeof(value));
+				return value;
+			}
+
+			std::string string(size_t position) const {
+				uint32_t offset = u32(position);
+				uint32_t length = u32(position + 4);
+				if ((uint64_t) offset + length >= strings_size) {
+					throw URDFParseError("Error! Binary model has a string outside of its string table");
+				}
+				return std::string(reinterpret_cast<const char*>(strings) + offset, length);
+			}
+
+			Transform transform(size_t position) const {
+				Transform t;
+				t.position = vector3(position);
+				t.rotation = Rotation(f64(position + 24), f64(position + 32), f64(position + 40), f64(position + 48));
+				return t;
+			}
+
+			Vector3 vector3(size_t position) const {
+				return Vector3(f64(position), f64(position + 8), f64(position + 16));
+			}
+
+			// offset of record 'index' in table 'table', after checking the index
+			size_t record(Table table, int64_t index) const {
+				if (index < 0 || index >= (int64_t) table_count[table]) {
+					throw URDFParseError("Error! Binary model refers to a record that does not exist");
+				}
+				return table_offset[table] + (size_t) index * record_size[table];
+			}
+
+			const unsigned char* data;
+			size_t size;
+			const unsigned char* strings;
+			size_t strings_size;
+			size_t table_offset[NUM_TABLES];
+			uint32_t table_count[NUM_TABLES];
+			size_t record_size[NUM_TABLES];
+	};
+
+	void writeGeometry(RecordWriter& out, const Geometry& geometry) {
+		out.u32(geometry.type);
+		out.u32(0);
+		std::string filename;
+		switch (geometry.type) {
+			case GeometryType::SPHERE:
+				out.f64(static_cast<const Sphere&>(geometry).radius);
+				out.f64(0.);
+				out.f64(0.);
+				break;
+			case GeometryType::BOX:
+				out.vector3(static_cast<const Box&>(geometry).dim);
+				break;
+			case GeometryType::CYLINDER:
+				out.f64(static_cast<const Cylinder&>(geometry).length);
+				out.f64(static_cast<const Cylinder&>(geometry).radius);
+				out.f64(0.);
+				break;
+			case GeometryType::CAPSULE:
+				out.f64(static_cast<const Capsule&>(geometry).length);
+				out.f64(static_cast<const Capsule&>(geometry).radius);
+				out.f64(0.);
+				break;
+			case GeometryType::MESH:
+				out.vector3(static_cast<const Mesh&>(geometry).scale);
+				filename = static_cast<const Mesh&>(geometry).filename;
+				break;
+		}
+		out.string(filename);
+		out.count++;
+	}
+
+	std::shared_ptr<Geometry> readGeometry(const BinaryReader& in, size_t p) {
+		switch (in.u32(p)) {
+			case GeometryType::SPHERE: {
+				auto sphere = std::make_shared<Sphere>();
+				sphere->radius = in.f64(p + 8);
+				return sphere;
+			}
+			case GeometryType::BOX: {
+				auto box = std::make_shared<Box>();
+				box->dim = in.vector3(p + 8);
+				return box;
+			}
+			case GeometryType::CYLINDER: {
+				auto cylinder = std::make_shared<Cylinder>();
+				cylinder->length = in.f64(p + 8);
+				cylinder->radius = in.f64(p + 16);
+				return cylinder;
+			}
+			case GeometryType::CAPSULE: {
+				auto capsule = std::make_shared<Capsule>();
+				capsule->length = in.f64(p + 8);
+				capsule->radius = in.f64(p + 16);
+				return capsule;
+			}
+			case GeometryType::MESH: {
+				auto mesh = std::make_shared<Mesh>();
+				mesh->scale = in.vector3(p + 8);
+				mesh->filename = in.string(p + 32);
+				return mesh;
+			}
+			default:
+				throw URDFParseError("Error! Binary model contains an unknown geometry type");
+		}
+	}
+
+	int32_t indexOf(const std::unordered_map<const void*, int32_t>& indices, const void* object) {
+		auto found = indices.find(object);
+		return found == indices.end() ? -1 : found->second;
+	}
+
+	// true if cacheOriginMatrices() ran on the model, which fills every matrix
+	bool hasOriginMatrices(const UrdfModel& model) {
+		if (!model.joint_map.empty()) {
+			return model.joint_map.begin()->second->parent_to_joint_matrix.has_value();
+		}
+		for (auto& entry : model.link_map) {
+			const Link& link = *entry.second;
+			if (link.inertial.has_value()) {
+				return link.inertial->origin_matrix.has_value();
+			}
+			if (!link.visuals.empty()) {
+				return link.visuals[0]->origin_matrix.has_value();
+			}
+			if (!link.collisions.empty()) {
+				return link.collisions[0]->origin_matrix.has_value();
+			}
+		}
+		return false;
+	}
+}
+
+uint64_t UrdfModel::contentHash(const char* data, size_t size) {
+	return hash64(data, size);
+}
+
+std::string UrdfModel::toBinary(uint64_t source_hash) const {
+	// number every object first, records refer to each other by index
+	std::vector<std::shared_ptr<Material>> materials;
+	std::unordered_map<const void*, int32_t> material_index;
+	for (auto& entry : material_map) {
+		material_index[entry.second.get()] = (int32_t) materials.size();
+		materials.push_back(entry.second);
+	}
+	size_t num_listed_materials = materials.size();
+
+	std::vector<std::shared_ptr<Link>> links;
+	std::unordered_map<const void*, int32_t> link_index;
+	for (auto& entry : link_map) {
+		link_index[entry.second.get()] = (int32_t) links.size();
+		links.push_back(entry.second);
+
+		for (auto& visual : entry.second->visuals) {
+			if (visual->material.has_value() && visual->material.value() &&
+			    material_index.count(visual->material.value().get()) == 0) {
+				material_index[visual->material.value().get()] = (int32_t) materials.size();
+				materials.push_back(visual->material.value());
+			}
+		}
+	}
+
+	std::vector<std::shared_ptr<Joint>> joints;
+	std::unordered_map<const void*, int32_t> joint_index;
+	for (auto& entry : joint_map) {
+		joint_index[entry.second.get()] = (int32_t) joints.size();
+		joints.push_back(entry.second);
+	}
+
+	StringTable strings;
+	RecordWriter tables[NUM_TABLES];
+	for (auto& table : tables) {
+		table.setStrings(&strings);
+	}
+
+	RecordWriter& material_table = tables[MATERIALS];
+	for (size_t i = 0; i < materials.size(); i++) {
+		const Material& material = *materials[i];
+		material_table.f32(material.color.r);
+		material_table.f32(material.color.g);
+		material_table.f32(material.color.b);
+		material_table.f32(material.color.a);
+		material_table.string(material.name);
+		material_table.string(material.texture_filename);
+		material_table.u32(i < num_listed_materials ? MATERIAL_IN_MAP : 0);
+		material_table.u32(0);
+		material_table.count++;
+	}
+
+	RecordWriter& geometry_table = tables[GEOMETRIES];
+	RecordWriter& visual_table = tables[VISUALS];
+	RecordWriter& collision_table = tables[COLLISIONS];
+	RecordWriter& link_table = tables[LINKS];
+	RecordWriter& child_table = tables[CHILDREN];
+	for (auto& link : links) {
+		Inertial inertial = link->inertial.value_or(Inertial());
+		link_table.transform(inertial.origin);
+		link_table.f64(inertial.mass);
+		link_table.f64(inertial.ixx);
+		link_table.f64(inertial.ixy);
+		link_table.f64(inertial.ixz);
+		link_table.f64(inertial.iyy);
+		link_table.f64(inertial.iyz);
+		link_table.f64(inertial.izz);
+		link_table.string(link->name);
+		link_table.u32(link->inertial.has_value() ? LINK_HAS_INERTIAL : 0);
+		link_table.i32(indexOf(link_index, link->getParent().get()));
+		link_table.i32(indexOf(joint_index, link->parent_joint.get()));
+		link_table.u32(visual_table.count);
+		link_table.u32((uint32_t) link->visuals.size());
+		link_table.u32(collision_table.count);
+		link_table.u32((uint32_t) link->collisions.size());
+		link_table.u32(child_table.count);
+		link_table.u32((uint32_t) link->child_joints.size());
+		link_table.u32(0);
+		link_table.count++;
+
+		for (auto& visual : link->visuals) {
+			visual_table.transform(visual->origin);
+			visual_table.string(visual->name);
+			visual_table.string(visual->material_name);
+			if (visual->geometry.has_value() && visual->geometry.value()) {
+				visual_table.i32((int32_t) geometry_table.count);
+				writeGeometry(geometry_table, *visual->geometry.value());
+			} else {
+				visual_table.i32(-1);
+			}
+			visual_table.i32(visual->material.has_value() && visual->material.value()
+			                 ? indexOf(material_index, visual->material.value().get()) : -1);
+			visual_table.count++;
+		}
+
+		for (auto& collision : link->collisions) {
+			collision_table.transform(collision->origin);
+			collision_table.string(collision->name);
+			if (collision->geometry.has_value() && collision->geometry.value()) {
+				collision_table.i32((int32_t) geometry_table.count);
+				writeGeometry(geometry_table, *collision->geometry.value());
+			} else {
+				collision_table.i32(-1);
+			}
+			collision_table.u32(0);
+			collision_table.count++;
+		}
+
+		for (size_t i = 0; i < link->child_joints.size(); i++) {
+			child_table.i32(indexOf(joint_index, link->child_joints[i].get()));
+			child_table.i32(indexOf(link_index, link->child_links[i].get()));
+			child_table.count++;
+		}
+	}
+
+	RecordWriter& joint_table = tables[JOINTS];
+	for (auto& joint : joints) {
+		uint32_t flags = 0;
+		joint_table.transform(joint->parent_to_joint_transform);
+		joint_table.vector3(joint->axis);
+
+		JointLimits limits;
+		if (joint->limits.has_value() && joint->limits.value()) {
+			limits = *joint->limits.value();
+			flags |= JOINT_LIMITS;
+		}
+		joint_table.f64(limits.lower);
+		joint_table.f64(limits.upper);
+		joint_table.f64(limits.effort);
+		joint_table.f64(limits.velocity);
+
+		JointSafety safety;
+		if (joint->safety.has_value() && joint->safety.value()) {
+			safety = *joint->safety.value();
+			flags |= JOINT_SAFETY;
+		}
+		joint_table.f64(safety.upper_limit);
+		joint_table.f64(safety.lower_limit);
+		joint_table.f64(safety.k_position);
+		joint_table.f64(safety.k_velocity);
+
+		JointDynamics dynamics;
+		if (joint->dynamics.has_value() && joint->dynamics.value()) {
+			dynamics = *joint->dynamics.value();
+			flags |= JOINT_DYNAMICS;
+		}
+		joint_table.f64(dynamics.damping);
+		joint_table.f64(dynamics.friction);
+
+		double rising = 0., falling = 0.;
+		if (joint->calibration.has_value() && joint->calibration.value()) {
+			const JointCalibration& calibration = *joint->calibration.value();
+			flags |= JOINT_CALIBRATION;
+			flags |= calibration.rising.has_value() ? JOINT_CALIBRATION_RISING : 0;
+			flags |= calibration.falling.has_value() ? JOINT_CALIBRATION_FALLING : 0;
+			rising = calibration.rising.value_or(0.);
+			falling = calibration.falling.value_or(0.);
+		}
+		joint_table.f64(rising);
+		joint_table.f64(falling);
+
+		JointMimic mimic;
+		if (joint->mimic.has_value() && joint->mimic.value()) {
+			mimic = *joint->mimic.value();
+			flags |= JOINT_MIMIC;
+		}
+		joint_table.f64(mimic.offset);
+		joint_table.f64(mimic.multiplier);
+
+		joint_table.string(joint->name);
+		joint_table.string(joint->parent_link_name);
+		joint_table.string(joint->child_link_name);
+		joint_table.string(mimic.joint_name);
+		joint_table.u32(joint->type);
+		joint_table.u32(flags);
+		joint_table.count++;
+	}
+
+	RecordWriter header;
+	header.setStrings(&strings);
+	header.data.append(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+	header.u32(BINARY_VERSION);
+	header.u32(HEADER_SIZE);
+	header.u64(source_hash);
+	header.u64(0);	// payload hash, filled in below
+	header.u64(0);	// total size
+	header.string(this->name);
+	header.i32(indexOf(link_index, root_link.get()));
+	header.u32(hasOriginMatrices(*this) ? ORIGIN_MATRICES : 0);
+
+	tables[STRINGS].data = strings.bytes;
+	tables[STRINGS].count = (uint32_t) strings.bytes.size();
+	while (tables[STRINGS].data.size() % 8 != 0) {
+		tables[STRINGS].data.push_back('\0');
+	}
+
+	// all record sizes are multiples of 8, so every table stays aligned
+	size_t offset = HEADER_SIZE;
+	for (auto& table : tables) {
+		header.u32((uint32_t) offset);
+		header.u32(table.count);
+		offset += table.data.size();
+	}
+	header.data.resize(HEADER_SIZE, '\0');
+
+	std::string binary;
+	binary.reserve(offset);
+	binary.append(header.data);
+	for (auto& table : tables) {
+		binary.append(table.data);
+	}
+
+	// payload hash and total size at offsets 24 and 32
+	uint64_t trailer[2] = { hash64(binary.data() + HEADER_SIZE, binary.size() - HEADER_SIZE), binary.size() };
+	for (int i = 0; i < 2; i++) {
+		for (int b = 0; b < 8; b++) {
+			binary[24 + 8 * i + b] = static_cast<char>(trailer[i] >> (8 * b));
+		}
+	}
+	return binary;
+}
+
+bool UrdfModel::binarySourceHash(const char* data, size_t size, uint64_t& source_hash) {
+	if (size < HEADER_SIZE || std::memcmp(data, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) {
+		return false;
+	}
+	BinaryReader in(data, size);
+	if (in.u32(8) != BINARY_VERSION) {
+		return false;
+	}
+	source_hash = in.u64(16);
+	return true;
+}
+
+std::shared_ptr<UrdfModel> UrdfModel::fromBinary(const char* data, size_t size) {
+	if (size < HEADER_SIZE || std::memcmp(data, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) {
+		throw URDFParseError("Error! Data is not a binary URDF model");
+	}
+
+	BinaryReader in(data, size);
+	if (in.u32(8) != BINARY_VERSION) {
+		std::ostringstream error_msg;
+		error_msg << "Error! Binary URDF model has version " << in.u32(8)
+		          << " but version " << BINARY_VERSION << " is expected";
+		throw URDFParseError(error_msg.str());
+	}
+	if (in.u32(12) != HEADER_SIZE || in.u64(32) != size) {
+		throw URDFParseError("Error! Binary URDF model is truncated");
+	}
+	if (in.u64(24) != hash64(data + HEADER_SIZE, size - HEADER_SIZE)) {
+		throw URDFParseError("Error! Binary URDF model is corrupted");
+	}
+
+	const size_t record_size[NUM_TABLES] = {
+		MATERIAL_SIZE, GEOMETRY_SIZE, VISUAL_SIZE, COLLISION_SIZE, LINK_SIZE, JOINT_SIZE, CHILD_SIZE, 1
+	};
+	for (int t = 0; t < NUM_TABLES; t++) {
+		in.table_offset[t] = in.u32(HEADER_TABLES + 8 * t);
+		in.table_count[t] = in.u32(HEADER_TABLES + 8 * t + 4);
+		in.record_size[t] = record_size[t];
+		if (in.table_offset[t] < HEADER_SIZE ||
+		    in.table_offset[t] + (uint64_t) in.table_count[t] * record_size[t] > size) {
+			throw URDFParseError("Error! Binary URDF model has a table outside of the file");
+		}
+	}
+	in.strings = in.data + in.table_offset[STRINGS];
+	in.strings_size = in.table_count[STRINGS];
+
+	std::shared_ptr<UrdfModel> model = std::make_shared<UrdfModel>();
+	model->name = in.string(40);
+
+	std::vector<std::shared_ptr<Material>> materials(in.table_count[MATERIALS]);
+	for (uint32_t i = 0; i < in.table_count[MATERIALS]; i++) {
+		size_t p = in.record(MATERIALS, i);
+		auto material = std::make_shared<Material>();
+		material->color = Color(in.f32(p), in.f32(p + 4), in.f32(p + 8), in.f32(p + 12));
+		material->name = in.string(p + 16);
+		material->texture_filename = in.string(p + 24);
+		if (in.u32(p + 32) & MATERIAL_IN_MAP) {
+			model->material_map[material->name] = material;
+		}
+		materials[i] = material;
+	}
+
+	std::vector<std::shared_ptr<Link>> links(in.table_count[LINKS]);
+	for (auto& link : links) {
+		link = std::make_shared<Link>();
+	}
+	std::vector<std::shared_ptr<Joint>> joints(in.table_count[JOINTS]);
+	for (auto& joint : joints) {
+		joint = std::make_shared<Joint>();
+	}
+
+	for (uint32_t i = 0; i < in.table_count[LINKS]; i++) {
+		size_t p = in.record(LINKS, i);
+		std::shared_ptr<Link> link = links[i];
+
+		link->name = in.string(p + 112);
+		if (in.u32(p + 120) & LINK_HAS_INERTIAL) {
+			Inertial inertial;
+			inertial.origin = in.transform(p);
+			inertial.mass = in.f64(p + 56);
+			inertial.ixx = in.f64(p + 64);
+			inertial.ixy = in.f64(p + 72);
+			inertial.ixz = in.f64(p + 80);
+			inertial.iyy = in.f64(p + 88);
+			inertial.iyz = in.f64(p + 96);
+			inertial.izz = in.f64(p + 104);
+			link->inertial = inertial;
+		}
+
+		int32_t parent_link = in.i32(p + 124);
+		if (parent_link >= 0) {
+			in.record(LINKS, parent_link);
+			link->setParentLink(links[parent_link]);
+		}
+		int32_t parent_joint = in.i32(p + 128);
+		if (parent_joint >= 0) {
+			in.record(JOINTS, parent_joint);
+			link->setParentJoint(joints[parent_joint]);
+		}
+
+		uint32_t first_visual = in.u32(p + 132);
+		uint32_t num_visuals = in.u32(p + 136);
+		for (uint32_t v = 0; v < num_visuals; v++) {
+			size_t vp = in.record(VISUALS, (int64_t) first_visual + v);
+			auto visual = std::make_shared<Visual>();
+			visual->origin = in.transform(vp);
+			visual->name = in.string(vp + 56);
+			visual->material_name = in.string(vp + 64);
+			int32_t geometry = in.i32(vp + 72);
+			if (geometry >= 0) {
+				visual->geometry = readGeometry(in, in.record(GEOMETRIES, geometry));
+			}
+			int32_t material = in.i32(vp + 76);
+			if (material >= 0) {
+				in.record(MATERIALS, material);
+				visual->material = materials[material];
+			}
+			link->visuals.push_back(visual);
+		}
+
+		uint32_t first_collision = in.u32(p + 140);
+		uint32_t num_collisions = in.u32(p + 144);
+		for (uint32_t c = 0; c < num_collisions; c++) {
+			size_t cp = in.record(COLLISIONS, (int64_t) first_collision + c);
+			auto collision = std::make_shared<Collision>();
+			collision->origin = in.transform(cp);
+			collision->name = in.string(cp + 56);
+			int32_t geometry = in.i32(cp + 64);
+			if (geometry >= 0) {
+				collision->geometry = readGeometry(in, in.record(GEOMETRIES, geometry));
+			}
+			link->collisions.push_back(collision);
+		}
+
+		uint32_t first_child = in.u32(p + 148);
+		uint32_t num_children = in.u32(p + 152);
+		for (uint32_t c = 0; c < num_children; c++) {
+			size_t cp = in.record(CHILDREN, (int64_t) first_child + c);
+			int32_t child_joint = in.i32(cp);
+			int32_t child_link = in.i32(cp + 4);
+			in.record(JOINTS, child_joint);
+			in.record(LINKS, child_link);
+			link->child_joints.push_back(joints[child_joint]);
+			link->child_links.push_back(links[child_link]);
+		}
+
+		model->link_map[link->name] = link;
+	}
+
+	for (uint32_t i = 0; i < in.table_count[JOINTS]; i++) {
+		size_t p = in.record(JOINTS, i);
+		std::shared_ptr<Joint> joint = joints[i];
+		uint32_t flags = in.u32(p + 228);
+
+		joint->parent_to_joint_transform = in.transform(p);
+		joint->axis = in.vector3(p + 56);
+		if (flags & JOINT_LIMITS) {
+			auto limits = std::make_shared<JointLimits>();
+			limits->lower = in.f64(p + 80);
+			limits->upper = in.f64(p + 88);
+			limits->effort = in.f64(p + 96);
+			limits->velocity = in.f64(p + 104);
+			joint->limits = limits;
+		}
+		if (flags & JOINT_SAFETY) {
+			auto safety = std::make_shared<JointSafety>();
+			safety->upper_limit = in.f64(p + 112);
+			safety->lower_limit = in.f64(p + 120);
+			safety->k_position = in.f64(p + 128);
+			safety->k_velocity = in.f64(p + 136);
+			joint->safety = safety;
+		}
+		if (flags & JOINT_DYNAMICS) {
+			auto dynamics = std::make_shared<JointDynamics>();
+			dynamics->damping = in.f64(p + 144);
+			dynamics->friction = in.f64(p + 152);
+			joint->dynamics = dynamics;
+		}
+		if (flags & JOINT_CALIBRATION) {
+			auto calibration = std::make_shared<JointCalibration>();
+			if (flags & JOINT_CALIBRATION_RISING) {
+				calibration->rising = in.f64(p + 160);
+			}
+			if (flags & JOINT_CALIBRATION_FALLING) {
+				calibration->falling = in.f64(p + 168);
+			}
+			joint->calibration = calibration;
+		}
+		if (flags & JOINT_MIMIC) {
+			auto mimic = std::make_shared<JointMimic>();
+			mimic->offset = in.f64(p + 176);
+			mimic->multiplier = in.f64(p + 184);
+			mimic->joint_name = in.string(p + 216);
+			joint->mimic = mimic;
+		}
+		joint->name = in.string(p + 192);
+		joint->parent_link_name = in.string(p + 200);
+		joint->child_link_name = in.string(p + 208);
+		uint32_t type = in.u32(p + 224);
+		if (type > JointType::FIXED) {
+			throw URDFParseError("Error! Binary model contains an unknown joint type");
+		}
+		joint->type = static_cast<JointType>(type);
+
+		model->joint_map[joint->name] = joint;
+	}
+
+	int32_t root_link = in.i32(48);
+	if (root_link >= 0) {
+		in.record(LINKS, root_link);
+		model->root_link = links[root_link];
+	}
+
+	if (in.u32(52) & ORIGIN_MATRICES) {
+		model->cacheOriginMatrices();
+	}
+	return model;
+}
+
+std::shared_ptr<UrdfModel> UrdfModel::fromBinaryFile(const std::string& path) {
+	MappedFile file(path);
+	return fromBinary(file.data(), file.size());
+}
@@ -0,0 +1,106 @@
+#include "urdf/model_cache.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace urdf;
+
+static std::shared_ptr<const FrozenModel> parseFrozen(const char* xml_buffer, size_t size, const ParseOptions& options) {
+	// the buffer does not have to be terminated, and is parsed in place
+	std::vector<char> buffer(xml_buffer, xml_buffer + size);
+	buffer.push_back('\0');
+	return UrdfModel::fromUrdfBufferInSitu(buffer.data(), options)->freeze();
+}
+
+ModelCache::ModelCache(size_t byte_budget, const ParseOptions& options)
+	: byte_budget(byte_budget), options(options), bytes(0), next_id(0), hits(0), misses(0), evictions(0) {}
+
+std::shared_ptr<const FrozenModel> ModelCache::fromUrdfStr(const std::string& xml_string) {
+	return fromUrdfBuffer(xml_string.data(), xml_string.size());
+}
+
+std::shared_ptr<const FrozenModel> ModelCache::fromUrdfBuffer(const char* xml_buffer, size_t size) {
+	Key key = { UrdfModel::contentHash(xml_buffer, size), size };
+
+	std::unique_lock<std::mutex> lock(mutex);
+	auto found = index.find(key);
+	if (found != index.end()) {
+		if (size > 0 && std::memcmp(found->second->document.data(), xml_buffer, size) != 0) {
+			// a different document with the same hash, parsed but not cached
+			misses++;
+			lock.unlock();
+			return parseFrozen(xml_buffer, size, options);
+		}
+		hits++;
+		entries.splice(entries.begin(), entries, found->second);
+		std::shared_future<std::shared_ptr<const FrozenModel>> model = found->second->model;
+		lock.unlock();
+		// waits if another thread is still parsing the document
+		return model.get();
+	}
+
+	misses++;
+	std::promise<std::shared_ptr<const FrozenModel>> parsed;
+	size_t id = next_id++;
+	entries.push_front(Entry{ key, id, std::string(xml_buffer, size), parsed.get_future().share(), size });
+	index[key] = entries.begin();
+	bytes += size;
+	evict();
+	lock.unlock();
+
+	std::shared_ptr<const FrozenModel> model;
+	try {
+		model = parseFrozen(xml_buffer, size, options);
+	} catch (...) {
+		parsed.set_exception(std::current_exception());
+		lock.lock();
+		// unless it was evicted and added again in the meantime
+		found = index.find(key);
+		if (found != index.end() && found->second->id == id) {
+			bytes -= found->second->charge;
+			entries.erase(found->second);
+			index.erase(found);
+		}
+		throw;
+	}
+	parsed.set_value(model);
+
+	size_t model_bytes = model->memoryUsage();
+	lock.lock();
+	found = index.find(key);
+	if (found != index.end() && found->second->id == id) {
+		found->second->charge += model_bytes;
+		bytes += model_bytes;
+		evict();
+	}
+	return model;
+}
+
+void ModelCache::evict() {
+	// never drop the entry that was just added, even if it alone exceeds the budget
+	while (bytes > byte_budget && entries.size() > 1) {
+		const Entry& oldest = entries.back();
+		bytes -= oldest.charge;
+		index.erase(oldest.key);
+		entries.pop_back();
+		evictions++;
+	}
+}
+
+ModelCache::Statistics ModelCache::statistics() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	Statistics statistics;
+	statistics.hits = hits;
+	statistics.misses = misses;
+	statistics.evictions = evictions;
+	statistics.entries = entries.size();
+	statistics.bytes = bytes;
+	return statistics;
+}
+
+void ModelCache::clear() {
+	std::lock_guard<std::mutex> lock(mutex);
+	entries.clear();
+	index.clear();
+	bytes = 0;
+}
@@ -0,0 +1,114 @@
+#include "urdf/name.h"
+#include "urdf/hash.h"
+#include "urdf/allocations.h"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace urdf {
+	namespace {
+		struct TextHash {
+			size_t operator()(std::string_view text) const {
+				return static_cast<size_t>(hash64(text.data(), text.size()));
+			}
+		};
+	}
+
+	// Split into shards by hash, so threads parsing different documents at
+	// the same time rarely wait for each other.
+	class NamePool {
+		public:
+			static const size_t NUM_SHARDS = 64;
+
+			Name::Entry* intern(std::string_view text) {
+				Shard& shard = shardOf(text);
+				std::lock_guard<std::mutex> lock(shard.mutex);
+				auto found = shard.index.find(text);
+				if (found != shard.index.end()) {
+					// may revive an entry whose last Name waits for the lock in drop()
+					found->second->references++;
+					return found->second;
+				}
+				Name::Entry* entry = new Name::Entry(text);
+				shard.index.emplace(std::string_view(entry->text), entry);
+				return entry;
+			}
+
+			// Counts down a reference that may be the last one. Done under the
+			// lock, so intern() cannot hand out the entry while it is deleted.
+			void drop(Name::Entry* entry) {
+				Shard& shard = shardOf(entry->text);
+				{
+					std::lock_guard<std::mutex> lock(shard.mutex);
+					if (--entry->references > 0) {
+						return;
+					}
+					shard.index.erase(std::string_view(entry->text));
+				}
+				delete entry;
+			}
+
+			size_t size() {
+				size_t num_names = 0;
+				for (Shard& shard : shards) {
+					std::lock_guard<std::mutex> lock(shard.mutex);
+					num_names += shard.index.size();
+				}
+				return num_names;
+			}
+
+		private:
+			struct Shard {
+				std::mutex mutex;
+				std::unordered_map<std::string_view, Name::Entry*, TextHash> index;
+			};
+
+			Shard& shardOf(std::string_view text) {
+				uint64_t hash = hash64(text.data(), text.size());
+				return shards[(hash >> 58) % NUM_SHARDS];
+			}
+
+			Shard shards[NUM_SHARDS];
+	};
+}
+
+using namespace urdf;
+
+namespace {
+	NamePool& pool() {
+		// never destroyed, names may still be used by static objects at exit
+		static NamePool* names = new NamePool();
+		return *names;
+	}
+}
+
+Name::Entry& Name::emptyEntry() {
+	static Entry* empty = new Entry("");
+	return *empty;
+}
+
+Name::Entry* Name::intern(std::string_view text) {
+	if (text.empty()) {
+		return &emptyEntry();
+	}
+	AllocationScope strings(AllocationSubsystem::STRINGS);
+	return pool().intern(text);
+}
+
+void Name::release(Entry* entry) {
+	if (entry->text.empty()) {
+		return;
+	}
+	// only the count down to zero needs the pool
+	size_t references = entry->references.load(std::memory_order_relaxed);
+	while (references > 1) {
+		if (entry->references.compare_exchange_weak(references, references - 1)) {
+			return;
+		}
+	}
+	pool().drop(entry);
+}
+
+size_t Name::poolSize() {
+	return pool().size();
+}
@@ -0,0 +1,55 @@
+#include "urdf/name_index.h"
+#include "urdf/hash.h"
+
+#include "memory_usage.h"
+
+using namespace urdf;
+
+NameIndex::NameIndex(const std::vector<std::string>& names) : names(names) {
+	size_t capacity = 8;
+	while (capacity < 2 * names.size()) {
+		capacity *= 2;
+	}
+	slots.assign(capacity, Slot{ 0, -1 });
+	mask = capacity - 1;
+
+	for (size_t i = 0; i < names.size(); i++) {
+		uint64_t hash = hash64(names[i].data(), names[i].size());
+		for (size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+			if (slots[slot].index < 0) {
+				slots[slot].hash = static_cast<uint32_t>(hash >> 32);
+				slots[slot].index = static_cast<int32_t>(i);
+				break;
+			}
+			if (names[slots[slot].index] == names[i]) {
+				break;
+			}
+		}
+	}
+}
+
+int NameIndex::find(std::string_view name) const {
+	if (slots.empty()) {
+		return -1;
+	}
+	// the low bits pick the slot, the high bits tell names in a chain apart
+	uint64_t hash = hash64(name.data(), name.size());
+	uint32_t tag = static_cast<uint32_t>(hash >> 32);
+	for (size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+		const Slot& entry = slots[slot];
+		if (entry.index < 0) {
+			return -1;
+		}
+		if (entry.hash == tag && names[entry.index] == name) {
+			return entry.index;
+		}
+	}
+}
+
+size_t NameIndex::memoryUsage() const {
+	size_t bytes = heapBytes(names) + heapBytes(slots);
+	for (const std::string& name : names) {
+		bytes += heapBytes(name);
+	}
+	return bytes;
+}
@@ -0,0 +1,117 @@
+#ifndef URDF_PARALLEL_H
+#define URDF_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "work_stealing_pool.h"
+
+namespace urdf {
+
+	/// Number of threads to use for a requested count, 0 meaning one per core.
+	inline unsigned int resolveThreadCount(unsigned int num_threads) {
+		if (num_threads == 0) {
+			num_threads = std::max(1u, std::thread::hardware_concurrency());
+		}
+		return num_threads;
+	}
+
+	/// The worker threads parallelFor() borrows, one per core, started on first
+	/// use. Never destroyed, a parse may still be running on another thread
+	/// while static objects are destroyed at exit.
+	inline WorkStealingPool& parallelPool() {
+		static WorkStealingPool* pool = new WorkStealingPool(resolveThreadCount(0));
+		return *pool;
+	}
+
+	/// Calls fn(i) for every i in [0, count) on up to num_threads threads, the
+	/// calling thread being one of them and the others borrowed from
+	/// parallelPool(). The indices are handed out in chunks of chunk_size from a
+	/// shared counter, so uneven work balances itself, and the calling thread
+	/// takes chunks until none are left, so the loop finishes even if the pool
+	/// is busy. fn must not throw, store the exceptions per index instead.
+	template<typename Fn>
+	void parallelFor(size_t count, unsigned int num_threads, size_t chunk_size, Fn fn) {
+		size_t num_chunks = (count + chunk_size - 1) / chunk_size;
+		num_threads = static_cast<unsigned int>(std::min<size_t>(resolveThreadCount(num_threads), num_chunks));
+		if (num_threads <= 1) {
+			for (size_t i = 0; i < count; i++) {
+				fn(i);
+			}
+			return;
+		}
+
+		// Shared with the pool tasks, which may only start after this call has
+		// returned. They touch fn only for a chunk they claimed, and this call
+		// waits until every chunk is done, so a late task finds no chunk left.
+		struct Loop {
+			std::atomic<size_t> next_chunk;
+			std::atomic<size_t> num_done;
+			std::mutex mutex;
+			std::condition_variable finished;
+		};
+		std::shared_ptr<Loop> loop = std::make_shared<Loop>();
+		loop->next_chunk = 0;
+		loop->num_done = 0;
+
+		Fn* body = &fn;
+		auto work = [loop, body, count, chunk_size, num_chunks]() {
+			for (size_t chunk = loop->next_chunk++; chunk < num_chunks; chunk = loop->next_chunk++) {
+				// the chunk counts as done even if fn throws, so the wait below ends
+				struct Done {
+					Loop& loop;
+					size_t num_chunks;
+					~Done() {
+						if (++loop.num_done == num_chunks) {
+							std::lock_guard<std::mutex> lock(loop.mutex);
+							loop.finished.notify_all();
+						}
+					}
+				} done{ *loop, num_chunks };
+				size_t end = std::min(count, (chunk + 1) * chunk_size);
+				for (size_t i = chunk * chunk_size; i < end; i++) {
+					(*body)(i);
+				}
+			}
+		};
+
+		try {
+			WorkStealingPool& pool = parallelPool();
+			size_t num_helpers = std::min<size_t>(num_threads - 1, pool.size());
+			for (size_t t = 0; t < num_helpers; t++) {
+				pool.submit(work);
+			}
+		} catch (...) {
+			// no pool or no memory for the tasks, the calling thread does the rest
+		}
+
+		std::exception_ptr error;
+		try {
+			work();
+		} catch (...) {
+			error = std::current_exception();
+			// drop the chunks nobody claimed yet, the pool may never get to them
+			for (size_t chunk = loop->next_chunk++; chunk < num_chunks; chunk = loop->next_chunk++) {
+				loop->num_done++;
+			}
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(loop->mutex);
+			loop->finished.wait(lock, [&]() { return loop->num_done == num_chunks; });
+		}
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+
+}
+
+#endif
@@ -0,0 +1,101 @@
+#include "urdf/parse_error.h"
+
+#include "tinyxml/txml.h"
+
+#include <cstring>
+
+using namespace urdf;
+
+ParseError::ParseError(ParseErrorCode code, const char* format, std::initializer_list<std::string_view> args)
+	: error_code(code), format(format), offset(-1), line_number(-1), column_number(-1) {
+	this->args.reserve(args.size());
+	for (std::string_view arg : args) {
+		this->args.emplace_back(arg);
+	}
+}
+
+std::string ParseError::message() const {
+	std::string text;
+	size_t next_arg = 0;
+	for (const char* p = format; *p != '\0'; p++) {
+		if (p[0] == '{' && p[1] == '}') {
+			if (next_arg < args.size()) {
+				text += args[next_arg++];
+			}
+			p++;
+		} else if (std::strncmp(p, "{cause}", 7) == 0) {
+			if (error_cause != nullptr) {
+				text += error_cause->message();
+			}
+			p += 6;
+		} else {
+			text += *p;
+		}
+	}
+	return text;
+}
+
+void ParseError::setCause(ParseError cause) {
+	error_cause = std::make_shared<const ParseError>(std::move(cause));
+}
+
+void ParseError::setElement(const TiXmlElement* element) {
+	if (element == nullptr) {
+		return;
+	}
+	offset = element->ByteOffset();
+
+	element_path.clear();
+	for (const TiXmlNode* node = element; node != nullptr && node->ToElement() != nullptr; node = node->Parent()) {
+		std::string step = "/" + node->ValueStr();
+		// the name of <robot> would only make the paths longer
+		bool is_root = node->Parent() == nullptr || node->Parent()->ToElement() == nullptr;
+		const char* name = node->ToElement()->Attribute("name");
+		if (name != nullptr && !is_root) {
+			step += "[@name='";
+			step += name;
+			step += "']";
+		}
+		element_path.insert(0, step);
+	}
+}
+
+void ParseError::setLocation(int offset, int line, int column) {
+	this->offset = offset;
+	line_number = line;
+	column_number = column;
+}
+
+URDFParseError ParseError::exception() const {
+	if (line_number >= 0) {
+		return URDFParseError(message(), offset, line_number, column_number);
+	}
+	return URDFParseError(message());
+}
+
+void ParseErrors::report(const TiXmlElement* element, ParseErrorCode code, const char* format,
+                         std::initializer_list<std::string_view> args) {
+	report(element, ParseError(code, format, args));
+}
+
+void ParseErrors::report(const TiXmlElement* element, ParseErrorCode code, const char* format,
+                         std::initializer_list<std::string_view> args, ParseError cause) {
+	ParseError error(code, format, args);
+	error.setCause(std::move(cause));
+	report(element, std::move(error));
+}
+
+void ParseErrors::report(const TiXmlElement* element, ParseError error) {
+	if (mode == THROW) {
+		// the caller knows where it is in the document and adds the location
+		throw error.exception();
+	}
+	reported++;
+	if (mode == FIRST && !errors.empty()) {
+		return;
+	}
+	if (error.elementPath().empty()) {
+		error.setElement(element);
+	}
+	errors.push_back(std::move(error));
+}
@@ -0,0 +1,64 @@
+#ifndef URDF_PHASE_CLOCK_H
+#define URDF_PHASE_CLOCK_H
+
+#include <chrono>
+#include <cstddef>
+
+#include "urdf/parse_stats.h"
+
+namespace urdf {
+
+	/// Books the wall time between laps, and counts, into a ParseStats. Does
+	/// nothing without one, and unless URDF_PARSE_STATS is defined every member
+	/// is empty, so the calls compile to nothing.
+	class PhaseClock {
+		public:
+#ifdef URDF_PARSE_STATS
+			explicit PhaseClock(ParseStats* stats) : stats(stats) {
+				if (stats != nullptr) {
+					last = std::chrono::steady_clock::now();
+				}
+			}
+
+			bool enabled() const { return stats != nullptr; }
+
+			/// Adds the time since the last lap to phase.
+			void lap(double ParseStats::*phase) {
+				if (stats != nullptr) {
+					auto now = std::chrono::steady_clock::now();
+					stats->*phase += std::chrono::duration<double>(now - last).count();
+					last = now;
+				}
+			}
+
+			/// Starts a new lap without booking the time since the last one.
+			void restart() {
+				if (stats != nullptr) {
+					last = std::chrono::steady_clock::now();
+				}
+			}
+
+			void count(size_t ParseStats::*counter, size_t n) {
+				if (stats != nullptr) {
+					stats->*counter += n;
+				}
+			}
+
+			ParseStats* get() const { return stats; }
+
+		private:
+			ParseStats* stats;
+			std::chrono::steady_clock::time_point last;
+#else
+			explicit PhaseClock(ParseStats*) {}
+			bool enabled() const { return false; }
+			void lap(double ParseStats::*) {}
+			void restart() {}
+			void count(size_t ParseStats::*, size_t) {}
+			ParseStats* get() const { return nullptr; }
+#endif
+	};
+
+}
+
+#endif
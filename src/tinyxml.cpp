@@ -49,6 +49,95 @@ FILE* TiXmlFOpen( const char* filename, const char* mode )
 	#endif
 }
 
+
+void* TiXmlArena::Allocate( size_t size )
+{
+	size = ( size + ALIGNMENT - 1 ) & ~( (size_t) ALIGNMENT - 1 );
+
+	if ( size > remaining )
+	{
+		size_t blockSize = nextBlockSize;
+		if ( blockSize < size )
+			blockSize = size;
+		if ( nextBlockSize < MAX_BLOCK_SIZE )
+			nextBlockSize *= 2;
+
+		// the block header is padded, so the data behind it stays aligned
+		const size_t headerSize = ( sizeof( Block ) + ALIGNMENT - 1 ) & ~( (size_t) ALIGNMENT - 1 );
+		char* memory = static_cast< char* >( ::operator new( headerSize + blockSize ) );
+
+		Block* block = reinterpret_cast< Block* >( memory );
+		block->next = blocks;
+		blocks = block;
+		++blockCount;
+
+		current = memory + headerSize;
+		remaining = blockSize;
+	}
+
+	void* result = current;
+	current += size;
+	remaining -= size;
+	return result;
+}
+
+
+void TiXmlArena::Release()
+{
+	while ( blocks )
+	{
+		Block* next = blocks->next;
+		::operator delete( blocks );
+		blocks = next;
+	}
+	current = 0;
+	remaining = 0;
+	nextBlockSize = FIRST_BLOCK_SIZE;
+	blockCount = 0;
+}
+
+
+// Every allocation starts with the arena it came from (null for the heap), padded
+// to the arena alignment so the object behind it is aligned as well.
+static const size_t TIXML_ALLOCATION_HEADER = TiXmlArena::ALIGNMENT;
+
+void* TiXmlBase::operator new( size_t size )
+{
+	return operator new( size, (TiXmlArena*) 0 );
+}
+
+
+void* TiXmlBase::operator new( size_t size, TiXmlArena* arena )
+{
+	char* memory;
+	if ( arena )
+		memory = static_cast< char* >( arena->Allocate( size + TIXML_ALLOCATION_HEADER ) );
+	else
+		memory = static_cast< char* >( ::operator new( size + TIXML_ALLOCATION_HEADER ) );
+
+	*reinterpret_cast< TiXmlArena** >( memory ) = arena;
+	return memory + TIXML_ALLOCATION_HEADER;
+}
+
+
+void TiXmlBase::operator delete( void* p )
+{
+	if ( !p )
+		return;
+
+	char* memory = static_cast< char* >( p ) - TIXML_ALLOCATION_HEADER;
+	// arena memory is released together with the arena
+	if ( *reinterpret_cast< TiXmlArena** >( memory ) == 0 )
+		::operator delete( memory );
+}
+
+
+void TiXmlBase::operator delete( void* p, TiXmlArena* /*arena*/ )
+{
+	operator delete( p );
+}
+
+
 void TiXmlBase::EncodeString( const TIXML_STRING& str, TIXML_STRING* outString )
 {
 	int i=0;
@@ -583,6 +672,28 @@ const char* TiXmlElement::Attribute( const char* name ) const
 }
 
 
+int TiXmlElement::Attributes( const char* const* names, const char** values, int count ) const
+{
+	for( int i=0; i<count; ++i )
+		values[i] = 0;
+
+	int found = 0;
+	for( const TiXmlAttribute* node = attributeSet.First(); node && found < count; node = node->Next() )
+	{
+		for( int i=0; i<count; ++i )
+		{
+			if ( !values[i] && strcmp( node->Name(), names[i] ) == 0 )
+			{
+				values[i] = node->Value();
+				++found;
+				break;
+			}
+		}
+	}
+	return found;
+}
+
+
 #ifdef TIXML_USE_STL
 const std::string* TiXmlElement::Attribute( const std::string& name ) const
 {
@@ -591,6 +702,15 @@ const std::string* TiXmlElement::Attribute( const std::string& name ) const
 		return &attrib->ValueStr();
 	return 0;
 }
+
+
+const char* TiXmlElement::AttributeValue( const std::string& name ) const
+{
+	const TiXmlAttribute* attrib = attributeSet.Find( name );
+	if ( attrib )
+		return attrib->Value();
+	return 0;
+}
 #endif
 
 
@@ -914,6 +1034,9 @@ TiXmlDocument::TiXmlDocument() : TiXmlNode( TiXmlNode::TINYXML_DOCUMENT )
 {
 	tabsize = 4;
 	useMicrosoftBOM = false;
+	parseListener = 0;
+	parsingInSitu = false;
+	useArena = false;
 	ClearError();
 }
 
@@ -921,6 +1044,9 @@ TiXmlDocument::TiXmlDocument( const char * documentName ) : TiXmlNode( TiXmlNode
 {
 	tabsize = 4;
 	useMicrosoftBOM = false;
+	parseListener = 0;
+	parsingInSitu = false;
+	useArena = false;
 	value = documentName;
 	ClearError();
 }
@@ -931,6 +1057,9 @@ TiXmlDocument::TiXmlDocument( const std::string& documentName ) : TiXmlNode( TiX
 {
 	tabsize = 4;
 	useMicrosoftBOM = false;
+	parseListener = 0;
+	parsingInSitu = false;
+	useArena = false;
     value = documentName;
 	ClearError();
 }
@@ -939,6 +1068,9 @@ TiXmlDocument::TiXmlDocument( const std::string& documentName ) : TiXmlNode( TiX
 
 TiXmlDocument::TiXmlDocument( const TiXmlDocument& copy ) : TiXmlNode( TiXmlNode::TINYXML_DOCUMENT )
 {
+	parseListener = 0;
+	parsingInSitu = false;
+	useArena = false;
 	copy.CopyTo( this );
 }
 
@@ -1212,9 +1344,9 @@ void TiXmlAttribute::Print( FILE* cfile, int /*depth*/, TIXML_STRING* str ) cons
 	TIXML_STRING n, v;
 
 	EncodeString( name, &n );
-	EncodeString( value, &v );
+	EncodeString( ValueStr(), &v );
 
-	if (value.find ('\"') == TIXML_STRING::npos) {
+	if (strchr (Value(), '\"') == 0) {
 		if ( cfile ) {
 			fprintf (cfile, "%s=\"%s\"", n.c_str(), v.c_str() );
 		}
@@ -1235,14 +1367,14 @@ void TiXmlAttribute::Print( FILE* cfile, int /*depth*/, TIXML_STRING* str ) cons
 
 int TiXmlAttribute::QueryIntValue( int* ival ) const
 {
-	if ( TIXML_SSCANF( value.c_str(), "%d", ival ) == 1 )
+	if ( TIXML_SSCANF( Value(), "%d", ival ) == 1 )
 		return TIXML_SUCCESS;
 	return TIXML_WRONG_TYPE;
 }
 
 int TiXmlAttribute::QueryDoubleValue( double* dval ) const
 {
-	if ( TIXML_SSCANF( value.c_str(), "%lf", dval ) == 1 )
+	if ( TIXML_SSCANF( Value(), "%lf", dval ) == 1 )
 		return TIXML_SUCCESS;
 	return TIXML_WRONG_TYPE;
 }
@@ -1271,12 +1403,12 @@ void TiXmlAttribute::SetDoubleValue( double _value )
 
 int TiXmlAttribute::IntValue() const
 {
-	return atoi (value.c_str ());
+	return atoi (Value());
 }
 
 double  TiXmlAttribute::DoubleValue() const
 {
-	return atof (value.c_str ());
+	return atof (Value());
 }
 
 
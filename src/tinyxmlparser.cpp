@@ -178,16 +178,19 @@ class TiXmlParsingData
 
   private:
 	// Only used by the document!
-	TiXmlParsingData( const char* start, int _tabsize, int row, int col )
+	TiXmlParsingData( const char* _start, int _tabsize, int row, int col )
 	{
-		assert( start );
-		stamp = start;
+		assert( _start );
+		start = _start;
+		stamp = _start;
 		tabsize = _tabsize;
 		cursor.row = row;
 		cursor.col = col;
+		cursor.offset = 0;
 	}
 
 	TiXmlCursor		cursor;
+	const char*		start;
 	const char*		stamp;
 	int				tabsize;
 };
@@ -197,7 +200,9 @@ void TiXmlParsingData::Stamp( const char* now, TiXmlEncoding encoding )
 {
 	assert( now );
 
-	// Do nothing if the tabsize is 0.
+	cursor.offset = (int)( now - start );
+
+	// Do nothing else if the tabsize is 0.
 	if ( tabsize < 1 )
 	{
 		return;
@@ -217,9 +222,11 @@ void TiXmlParsingData::Stamp( const char* now, TiXmlEncoding encoding )
 		// Code contributed by Fletcher Dunn: (modified by lee)
 		switch (*pU) {
 			case 0:
-				// We *should* never get here, but in case we do, don't
-				// advance past the terminating null character, ever
-				return;
+				// 'now' is never past the end of the text, so this is a closing
+				// quote that ParseInSitu() replaced by a terminator.
+				++p;
+				++col;
+				break;
 
 			case '\r':
 				// bump down to the next line
@@ -701,6 +708,14 @@ void TiXmlDocument::StreamIn( std::istream * in, TIXML_STRING * tag )
 
 #endif
 
+const char* TiXmlDocument::ParseInSitu( char* p, TiXmlParsingData* prevData, TiXmlEncoding encoding )
+{
+	parsingInSitu = true;
+	const char* result = Parse( p, prevData, encoding );
+	parsingInSitu = false;
+	return result;
+}
+
 const char* TiXmlDocument::Parse( const char* p, TiXmlParsingData* prevData, TiXmlEncoding encoding )
 {
 	ClearError();
@@ -757,6 +772,21 @@ const char* TiXmlDocument::Parse( const char* p, TiXmlParsingData* prevData, TiX
 		if ( node )
 		{
 			p = node->Parse( p, &data, encoding );
+			if ( parseListener && !error && node->ToElement() )
+			{
+				TiXmlParseListener::Result result = parseListener->ElementParsed( this, node->ToElement(), 1 );
+				if ( result != TiXmlParseListener::KEEP )
+				{
+					delete node;
+					if ( result == TiXmlParseListener::STOP )
+					{
+						SetError( TIXML_ERROR_PARSING_STOPPED, p, &data, encoding );
+						return 0;
+					}
+					p = SkipWhiteSpace( p, encoding );
+					continue;
+				}
+			}
 			LinkEndChild( node );
 		}
 		else
@@ -811,10 +841,21 @@ void TiXmlDocument::SetError( int err, const char* pError, TiXmlParsingData* dat
 	{
 		data->Stamp( pError, encoding );
 		errorLocation = data->Cursor();
+		if ( tabsize < 1 )
+			errorLocation = LocationOf( data->start, errorLocation.offset, encoding );
 	}
 }
 
 
+TiXmlCursor TiXmlDocument::LocationOf( const char* start, int offset, TiXmlEncoding encoding ) const
+{
+	TiXmlParsingData data( start, tabsize > 0 ? tabsize : 4, 0, 0 );
+	if ( offset > 0 )
+		data.Stamp( start + offset, encoding );
+	return data.Cursor();
+}
+
+
 TiXmlNode* TiXmlNode::Identify( const char* p, TiXmlEncoding encoding )
 {
 	TiXmlNode* returnNode = 0;
@@ -839,6 +880,9 @@ TiXmlNode* TiXmlNode::Identify( const char* p, TiXmlEncoding encoding )
 	// - Everthing else is unknown to tinyxml.
 	//
 
+	TiXmlDocument* document = GetDocument();
+	TiXmlArena* arena = document ? document->Arena() : 0;
+
 	const char* xmlHeader = { "<?xml" };
 	const char* commentHeader = { "<!--" };
 	const char* dtdHeader = { "<!" };
@@ -849,21 +893,21 @@ TiXmlNode* TiXmlNode::Identify( const char* p, TiXmlEncoding encoding )
 		#ifdef DEBUG_PARSER
 			TIXML_LOG( "XML parsing Declaration\n" );
 		#endif
-		returnNode = new TiXmlDeclaration();
+		returnNode = new ( arena ) TiXmlDeclaration();
 	}
 	else if ( StringEqual( p, commentHeader, false, encoding ) )
 	{
 		#ifdef DEBUG_PARSER
 			TIXML_LOG( "XML parsing Comment\n" );
 		#endif
-		returnNode = new TiXmlComment();
+		returnNode = new ( arena ) TiXmlComment();
 	}
 	else if ( StringEqual( p, cdataHeader, false, encoding ) )
 	{
 		#ifdef DEBUG_PARSER
 			TIXML_LOG( "XML parsing CDATA\n" );
 		#endif
-		TiXmlText* text = new TiXmlText( "" );
+		TiXmlText* text = new ( arena ) TiXmlText( "" );
 		text->SetCDATA( true );
 		returnNode = text;
 	}
@@ -872,7 +916,7 @@ TiXmlNode* TiXmlNode::Identify( const char* p, TiXmlEncoding encoding )
 		#ifdef DEBUG_PARSER
 			TIXML_LOG( "XML parsing Unknown(1)\n" );
 		#endif
-		returnNode = new TiXmlUnknown();
+		returnNode = new ( arena ) TiXmlUnknown();
 	}
 	else if (    IsAlpha( *(p+1), encoding )
 			  || *(p+1) == '_' )
@@ -880,14 +924,14 @@ TiXmlNode* TiXmlNode::Identify( const char* p, TiXmlEncoding encoding )
 		#ifdef DEBUG_PARSER
 			TIXML_LOG( "XML parsing Element\n" );
 		#endif
-		returnNode = new TiXmlElement( "" );
+		returnNode = new ( arena ) TiXmlElement( "" );
 	}
 	else
 	{
 		#ifdef DEBUG_PARSER
 			TIXML_LOG( "XML parsing Unknown(2)\n" );
 		#endif
-		returnNode = new TiXmlUnknown();
+		returnNode = new ( arena ) TiXmlUnknown();
 	}
 
 	if ( returnNode )
@@ -1139,7 +1183,7 @@ const char* TiXmlElement::Parse( const char* p, TiXmlParsingData* data, TiXmlEnc
 		else
 		{
 			// Try to read an attribute:
-			TiXmlAttribute* attrib = new TiXmlAttribute();
+			TiXmlAttribute* attrib = new ( document ? document->Arena() : 0 ) TiXmlAttribute();
 			if ( !attrib )
 			{
 				return 0;
@@ -1189,7 +1233,7 @@ const char* TiXmlElement::ReadValue( const char* p, TiXmlParsingData* data, TiXm
 		if ( *p != '<' )
 		{
 			// Take what we have, make a text element.
-			TiXmlText* textNode = new TiXmlText( "" );
+			TiXmlText* textNode = new ( document ? document->Arena() : 0 ) TiXmlText( "" );
 
 			if ( !textNode )
 			{
@@ -1227,6 +1271,28 @@ const char* TiXmlElement::ReadValue( const char* p, TiXmlParsingData* data, TiXm
 				if ( node )
 				{
 					p = node->Parse( p, data, encoding );
+
+					TiXmlParseListener* listener = document ? document->ParseListener() : 0;
+					if ( listener && !document->Error() && node->ToElement() )
+					{
+						int depth = 1;
+						for ( const TiXmlNode* ancestor = this; ancestor && !ancestor->ToDocument(); ancestor = ancestor->Parent() )
+							++depth;
+
+						TiXmlParseListener::Result result = listener->ElementParsed( this, node->ToElement(), depth );
+						if ( result != TiXmlParseListener::KEEP )
+						{
+							delete node;
+							if ( result == TiXmlParseListener::STOP )
+							{
+								document->SetError( TIXML_ERROR_PARSING_STOPPED, p, data, encoding );
+								return 0;
+							}
+							pWithWhiteSpace = p;
+							p = SkipWhiteSpace( p, encoding );
+							continue;
+						}
+					}
 					LinkEndChild( node );
 				}				
 				else
@@ -1389,6 +1455,34 @@ const char* TiXmlComment::Parse( const char* p, TiXmlParsingData* data, TiXmlEnc
 }
 
 
+const char* TiXmlAttribute::FindInSituValueEnd( const char* p, char quote, TiXmlEncoding encoding )
+{
+	// Steps through the characters the same way ReadText() does, so both agree on
+	// where the value ends.
+	while ( *p && *p != quote )
+	{
+		int length = ( encoding == TIXML_ENCODING_UTF8 ) ? utf8ByteTable[ *((const unsigned char*)p) ] : 1;
+		if ( length == 1 )
+		{
+			if ( *p == '&' )
+				return 0;
+			++p;
+		}
+		else
+		{
+			if ( length == 0 )
+				return 0;
+			for ( int i=1; i<length; ++i )
+			{
+				if ( !p[i] )
+					return 0;
+			}
+			p += length;
+		}
+	}
+	return *p ? p : 0;
+}
+
 const char* TiXmlAttribute::Parse( const char* p, TiXmlParsingData* data, TiXmlEncoding encoding )
 {
 	p = SkipWhiteSpace( p, encoding );
@@ -1426,7 +1520,27 @@ const char* TiXmlAttribute::Parse( const char* p, TiXmlParsingData* data, TiXmlE
 	const char SINGLE_QUOTE = '\'';
 	const char DOUBLE_QUOTE = '\"';
 
-	if ( *p == SINGLE_QUOTE )
+	const char* insituEnd = 0;
+	if ( *p == SINGLE_QUOTE || *p == DOUBLE_QUOTE )
+		insituEnd = FindInSituValueEnd( p + 1, *p, encoding );
+
+	if ( insituEnd && document && document->ParsingInSitu() )
+	{
+		// Use the value straight from the buffer. The cursor has to move past the
+		// closing quote before it is replaced by the terminating zero.
+		insituValue = p + 1;
+		p = insituEnd + 1;
+		if ( data )
+			data->Stamp( p, encoding );
+		*const_cast< char* >( insituEnd ) = 0;
+	}
+	else if ( insituEnd )
+	{
+		// Nothing to decode, copy the value in one go instead of through ReadText().
+		value.assign( p + 1, insituEnd );
+		p = insituEnd + 1;
+	}
+	else if ( *p == SINGLE_QUOTE )
 	{
 		++p;
 		end = "\'";		// single quote in string
@@ -0,0 +1,138 @@
+#include "urdf/value_model.h"
+#include "urdf/compiled_model.h"
+#include "urdf/model.h"
+
+#include <map>
+
+#include "memory_usage.h"
+
+using namespace urdf;
+
+static std::optional<GeometryValue> geometryValue(const std::optional<std::shared_ptr<Geometry>>& geometry) {
+	if (!geometry.has_value() || geometry.value() == nullptr) {
+		return std::nullopt;
+	}
+	const Geometry& shape = *geometry.value();
+	switch (shape.type) {
+		case GeometryType::SPHERE:
+			return GeometryValue(static_cast<const Sphere&>(shape));
+		case GeometryType::BOX:
+			return GeometryValue(static_cast<const Box&>(shape));
+		case GeometryType::CYLINDER:
+			return GeometryValue(static_cast<const Cylinder&>(shape));
+		case GeometryType::CAPSULE:
+			return GeometryValue(static_cast<const Capsule&>(shape));
+		case GeometryType::MESH:
+			return GeometryValue(static_cast<const Mesh&>(shape));
+	}
+	return std::nullopt;
+}
+
+template<typename T>
+static std::optional<T> propertyValue(const std::optional<std::shared_ptr<T>>& property) {
+	if (!property.has_value() || property.value() == nullptr) {
+		return std::nullopt;
+	}
+	return *property.value();
+}
+
+ValueModel ValueModel::fromUrdfModel(const UrdfModel& model) {
+	return fromUrdfModel(model, *CompiledModel::fromUrdfModel(model));
+}
+
+ValueModel ValueModel::fromUrdfModel(const UrdfModel& model, const CompiledModel& compiled) {
+	ValueModel values;
+	values.name = model.name;
+
+	std::vector<std::string> names;
+	std::map<const Material*, int> material_indices;
+	values.materials.reserve(model.material_map.size());
+	for (auto& entry : model.material_map) {
+		material_indices[entry.second.get()] = static_cast<int>(values.materials.size());
+		values.materials.push_back(*entry.second);
+		names.push_back(entry.first);
+	}
+	values.material_names = NameIndex(names);
+
+	names.clear();
+	values.links.resize(compiled.numLinks());
+	for (size_t i = 0; i < compiled.numLinks(); i++) {
+		const Link& link = *compiled.links[i];
+		LinkValue& value = values.links[i];
+		value.name = link.name;
+		value.inertial = link.inertial;
+		value.parent_link = compiled.link_parent[i];
+		value.parent_joint = compiled.link_parent_joint[i];
+		if (value.parent_link >= 0) {
+			values.links[value.parent_link].child_links.push_back(static_cast<int>(i));
+		}
+
+		value.visuals.reserve(link.visuals.size());
+		for (auto& visual : link.visuals) {
+			int material = -1;
+			if (visual->material.has_value() && visual->material.value() != nullptr) {
+				auto found = material_indices.find(visual->material.value().get());
+				if (found == material_indices.end()) {
+					// a material that is only used by this visual
+					found = material_indices.emplace(visual->material.value().get(),
+					                                 static_cast<int>(values.materials.size())).first;
+					values.materials.push_back(*visual->material.value());
+				}
+				material = found->second;
+			}
+			value.visuals.push_back(VisualValue{ visual->name, visual->origin, geometryValue(visual->geometry), material });
+		}
+
+		value.collisions.reserve(link.collisions.size());
+		for (auto& collision : link.collisions) {
+			value.collisions.push_back(CollisionValue{ collision->name, collision->origin, geometryValue(collision->geometry) });
+		}
+		names.push_back(link.name);
+	}
+	values.link_names = NameIndex(names);
+
+	names.clear();
+	values.joints.reserve(compiled.numJoints());
+	for (size_t j = 0; j < compiled.numJoints(); j++) {
+		const Joint& joint = *compiled.joints[j];
+		JointValue value;
+		value.name = joint.name;
+		value.type = joint.type;
+		value.axis = joint.axis;
+		value.parent_to_joint_transform = joint.parent_to_joint_transform;
+		value.parent_link = compiled.joint_parent_link[j];
+		value.child_link = compiled.joint_child_link[j];
+		value.dynamics = propertyValue(joint.dynamics);
+		value.limits = propertyValue(joint.limits);
+		value.safety = propertyValue(joint.safety);
+		value.calibration = propertyValue(joint.calibration);
+		value.mimic = propertyValue(joint.mimic);
+		values.joints.push_back(value);
+		names.push_back(joint.name);
+	}
+	values.joint_names = NameIndex(names);
+
+	return values;
+}
+
+static size_t geometryBytes(const std::optional<GeometryValue>& geometry) {
+	const Mesh* mesh = geometry.has_value() ? std::get_if<Mesh>(&*geometry) : nullptr;
+	return mesh != nullptr ? heapBytes(mesh->filename) : 0;
+}
+
+size_t ValueModel::memoryUsage() const {
+	size_t bytes = heapBytes(materials) + heapBytes(links) + heapBytes(joints);
+	for (const Material& material : materials) {
+		bytes += heapBytes(material.texture_filename);
+	}
+	for (const LinkValue& link : links) {
+		bytes += heapBytes(link.visuals) + heapBytes(link.collisions) + heapBytes(link.child_links);
+		for (const VisualValue& visual : link.visuals) {
+			bytes += heapBytes(visual.name) + geometryBytes(visual.geometry);
+		}
+		for (const CollisionValue& collision : link.collisions) {
+			bytes += heapBytes(collision.name) + geometryBytes(collision.geometry);
+		}
+	}
+	return bytes + link_names.memoryUsage() + joint_names.memoryUsage() + material_names.memoryUsage();
+}
@@ -0,0 +1,127 @@
+#ifndef URDF_WORK_STEALING_POOL_H
+#define URDF_WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace urdf {
+
+	/// Fixed number of worker threads, each with its own task queue. A worker
+	/// takes the newest task of its own queue first and steals the oldest task
+	/// of another queue when its own is empty, so a burst of submissions from one
+	/// thread spreads over all workers without a single contended queue.
+	///
+	/// The destructor runs all tasks that are still queued before it joins the
+	/// workers. Tasks must not throw.
+	class WorkStealingPool {
+		public:
+			explicit WorkStealingPool(unsigned int num_threads)
+				: queues(num_threads), next_queue(0), num_queued(0), stopping(false) {
+				for (auto& queue : queues) {
+					queue.reset(new Queue());
+				}
+				workers.reserve(num_threads);
+				for (unsigned int i = 0; i < num_threads; i++) {
+					workers.emplace_back(&WorkStealingPool::run, this, i);
+				}
+			}
+
+			~WorkStealingPool() {
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					stopping = true;
+				}
+				wakeup.notify_all();
+				for (auto& worker : workers) {
+					worker.join();
+				}
+			}
+
+			size_t size() const { return workers.size(); }
+
+			void submit(std::function<void()> task) {
+				// a task submitted by a worker stays local to it, others are spread round robin
+				size_t index = (current_pool == this) ? current_worker : next_queue++ % queues.size();
+				{
+					std::lock_guard<std::mutex> lock(queues[index]->mutex);
+					queues[index]->tasks.push_back(std::move(task));
+				}
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					num_queued++;
+				}
+				wakeup.notify_one();
+			}
+
+		private:
+			WorkStealingPool(const WorkStealingPool&) = delete;
+			WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+			struct Queue {
+				std::mutex mutex;
+				std::deque<std::function<void()>> tasks;
+			};
+
+			bool take(size_t index, std::function<void()>& task) {
+				for (size_t i = 0; i < queues.size(); i++) {
+					Queue& queue = *queues[(index + i) % queues.size()];
+					std::lock_guard<std::mutex> lock(queue.mutex);
+					if (queue.tasks.empty()) {
+						continue;
+					}
+					if (i == 0) {
+						task = std::move(queue.tasks.back());
+						queue.tasks.pop_back();
+					} else {
+						task = std::move(queue.tasks.front());
+						queue.tasks.pop_front();
+					}
+					return true;
+				}
+				return false;
+			}
+
+			void run(size_t index) {
+				current_pool = this;
+				current_worker = index;
+				for (;;) {
+					{
+						std::unique_lock<std::mutex> lock(mutex);
+						wakeup.wait(lock, [this]() { return num_queued > 0 || stopping; });
+						if (num_queued == 0) {
+							return;
+						}
+						num_queued--;
+					}
+					// num_queued counted this task, so some queue holds one for us
+					std::function<void()> task;
+					while (!take(index, task)) {
+						std::this_thread::yield();
+					}
+					task();
+				}
+			}
+
+			std::vector<std::unique_ptr<Queue>> queues;
+			std::vector<std::thread> workers;
+			std::atomic<size_t> next_queue;
+
+			std::mutex mutex;
+			std::condition_variable wakeup;
+			size_t num_queued;
+			bool stopping;
+
+			inline static thread_local WorkStealingPool* current_pool = nullptr;
+			inline static thread_local size_t current_worker = 0;
+	};
+
+}
+
+#endif
@@ -0,0 +1,138 @@
+#include "catch2/catch.hpp"
+#include "urdf/model.h"
+#include "urdf/allocations.h"
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace urdf;
+
+// The reference arm: a chain of 50 links, each with an inertial, a mesh visual
+// with a shared material and a box collision, joined by revolute joints.
+static std::string referenceArm() {
+    std::ostringstream xml;
+    xml << "<robot name=\"reference_arm\">\n"
+        << "  <material name=\"grey\"><color rgba=\"0.5 0.5 0.5 1\"/></material>\n";
+    for (int i = 0; i < 50; i++) {
+        xml << "  <link name=\"arm_link_" << i << "\">\n"
+            << "    <inertial><origin xyz=\"0 0 0.1\"/><mass value=\"1.5\"/>\n"
+            << "      <inertia ixx=\"0.01\" ixy=\"0\" ixz=\"0\" iyy=\"0.01\" iyz=\"0\" izz=\"0.004\"/></inertial>\n"
+            << "    <visual><geometry><mesh filename=\"package://reference_arm/meshes/arm_link_" << i << ".stl\"/>"
+            << "</geometry><material name=\"grey\"/></visual>\n"
+            << "    <collision><geometry><box size=\"0.08 0.08 0.25\"/></geometry></collision>\n"
+            << "  </link>\n";
+        if (i > 0) {
+            xml << "  <joint name=\"arm_joint_" << i << "\" type=\"revolute\">\n"
+                << "    <parent link=\"arm_link_" << i - 1 << "\"/><child link=\"arm_link_" << i << "\"/>\n"
+                << "    <origin xyz=\"0 0 0.2\"/><axis xyz=\"0 0 1\"/>\n"
+                << "    <limit effort=\"150\" lower=\"-2.9\" upper=\"2.9\" velocity=\"1.7\"/>\n"
+                << "  </joint>\n";
+        }
+    }
+    xml << "</robot>\n";
+    return xml.str();
+}
+
+static AllocationReport countParse(const std::string& xml, const ParseOptions& options = ParseOptions()) {
+    AllocationTracker tracker;
+    UrdfModel::fromUrdfStr(xml, options);
+    return tracker.report();
+}
+
+TEST_CASE ( "the allocation tracker counts the allocations of its lifetime", "[AllocationTracker]" ) {
+    REQUIRE(AllocationTracker::hooked());
+
+    AllocationTracker tracker;
+    std::vector<int> numbers(100);
+    AllocationReport report = tracker.report();
+    CHECK(report.total().allocations == 1);
+    CHECK(report.total().bytes == 100 * sizeof(int));
+    CHECK(report[AllocationSubsystem::OTHER].allocations == 1);
+
+    if (AllocationTracker::enabled) {
+        AllocationTracker geometry_tracker;
+        {
+            AllocationScope scope(AllocationSubsystem::GEOMETRY);
+            numbers.resize(1000);
+        }
+        numbers.resize(10000);
+        AllocationReport tagged = geometry_tracker.report();
+        CHECK(tagged[AllocationSubsystem::GEOMETRY].allocations == 1);
+        CHECK(tagged[AllocationSubsystem::GEOMETRY].bytes == 1000 * sizeof(int));
+        CHECK(tagged[AllocationSubsystem::OTHER].allocations == 1);
+    }
+}
+
+TEST_CASE ( "the allocation tracker keeps the blocks that are still live", "[AllocationTracker]" ) {
+    REQUIRE(AllocationTracker::hooked());
+    struct alignas(64) CacheLine {
+        char bytes[64];
+    };
+
+    std::unique_ptr<int> older(new int(1));
+    AllocationTracker tracker;
+    AllocationReport live, freed, leaked;
+    bool aligned;
+    {
+        std::vector<int> numbers(1000);
+        std::unique_ptr<CacheLine> line(new CacheLine());
+        aligned = reinterpret_cast<std::uintptr_t>(line.get()) % alignof(CacheLine) == 0;
+        live = tracker.report();
+    }
+    freed = tracker.report();
+    // freeing a block from before the tracker does not make up for a leak
+    int* volatile leak = new int(2);
+    older.reset();
+    leaked = tracker.report();
+    delete leak;
+
+    CHECK(aligned);
+    CHECK(live.total().allocations == 2);
+    CHECK(live.live_blocks == 2);
+    CHECK(live.live_bytes == static_cast<long>(1000 * sizeof(int) + sizeof(CacheLine)));
+    CHECK(freed.live_blocks == 0);
+    CHECK(freed.live_bytes == 0);
+    CHECK(freed.peak_live_bytes == live.live_bytes);
+    CHECK(leaked.live_blocks == 1);
+    CHECK(leaked.live_bytes == static_cast<long>(sizeof(int)));
+}
+
+TEST_CASE ( "parsing the reference arm stays within its allocation budget", "[AllocationTracker]" ) {
+    const std::string xml = referenceArm();
+    // names still used by another model are not allocated again
+    auto first = UrdfModel::fromUrdfStr(xml);
+
+    AllocationReport report = countParse(xml);
+    CHECK(report.total().allocations < 1000);
+    // mostly the arena blocks of the DOM
+    CHECK(report.total().bytes < 800000);
+
+    ParseOptions streaming;
+    streaming.streaming = true;
+    // a heap node per element and attribute, but the DOM never holds more than one link
+    AllocationReport streamed = countParse(xml, streaming);
+    CHECK(streamed.total().allocations < 3500);
+    CHECK(streamed.total().bytes < 600000);
+
+    if (!AllocationTracker::enabled) {
+        return;
+    }
+
+    // one per mesh and box, the mesh file names are strings
+    CHECK(report[AllocationSubsystem::GEOMETRY].allocations == 100);
+    CHECK(report[AllocationSubsystem::STRINGS].allocations == 50);
+    CHECK(report[AllocationSubsystem::XML_DOM].allocations > 0);
+    CHECK(report[AllocationSubsystem::XML_DOM].allocations < 100);
+    // a node per link, joint and material, the link tree and its lookup table
+    CHECK(report[AllocationSubsystem::MAPS].allocations < 300);
+
+    // names that are new to the pool count as strings
+    std::string renamed = xml;
+    for (size_t at = renamed.find("arm_"); at != std::string::npos; at = renamed.find("arm_", at)) {
+        renamed.replace(at, 4, "new_");
+    }
+    CHECK(countParse(renamed)[AllocationSubsystem::STRINGS].allocations > 100);
+}
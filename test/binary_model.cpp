@@ -0,0 +1,201 @@
+#include "catch2/catch.hpp"
+#include "urdf/model.h"
+#include "urdf/hash.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+static const char* urdfstr_full =
+    "<robot name=\"full\">\n"
+    "  <material name=\"blue\"><color rgba=\"0 0 0.8 1\"/><texture filename=\"blue.png\"/></material>\n"
+    "  <link name=\"base\">\n"
+    "    <inertial><origin xyz=\"0 0 0.1\" rpy=\"0 0.5 0\"/><mass value=\"2.5\"/>\n"
+    "      <inertia ixx=\"1\" ixy=\"0.1\" ixz=\"0.2\" iyy=\"2\" iyz=\"0.3\" izz=\"3\"/></inertial>\n"
+    "    <visual name=\"body\"><origin xyz=\"1 2 3\"/><geometry><box size=\"1 2 3\"/></geometry>\n"
+    "      <material name=\"blue\"/></visual>\n"
+    "    <visual><geometry><mesh filename=\"package://robot/base.stl\" scale=\"0.1 0.2 0.3\"/></geometry>\n"
+    "      <material name=\"red\"><color rgba=\"1 0 0 1\"/></material></visual>\n"
+    "    <collision><geometry><cylinder length=\"0.5\" radius=\"0.1\"/></geometry></collision>\n"
+    "    <collision name=\"cap\"><geometry><capsule length=\"0.4\" radius=\"0.2\"/></geometry></collision>\n"
+    "  </link>\n"
+    "  <link name=\"arm\"><collision><geometry><sphere radius=\"0.05\"/></geometry></collision></link>\n"
+    "  <link name=\"finger\"/>\n"
+    "  <joint name=\"shoulder\" type=\"revolute\">\n"
+    "    <parent link=\"base\"/><child link=\"arm\"/>\n"
+    "    <origin xyz=\"0 0 1\" rpy=\"0.1 0.2 0.3\"/><axis xyz=\"0 1 0\"/>\n"
+    "    <limit lower=\"-1\" upper=\"1\" effort=\"10\" velocity=\"2\"/>\n"
+    "    <safety_controller soft_lower_limit=\"-0.9\" k_position=\"5\" k_velocity=\"6\"/>\n"
+    "    <dynamics damping=\"0.3\" friction=\"0.4\"/>\n"
+    "    <calibration rising=\"0.25\"/>\n"
+    "  </joint>\n"
+    "  <joint name=\"grip\" type=\"prismatic\">\n"
+    "    <parent link=\"arm\"/><child link=\"finger\"/>\n"
+    "    <limit effort=\"1\" velocity=\"1\"/>\n"
+    "    <mimic joint=\"shoulder\" multiplier=\"2\" offset=\"0.5\"/>\n"
+    "  </joint>\n"
+    "</robot>";
+
+using namespace urdf;
+
+TEST_CASE ( "hash64 matches the XXH64 reference values", "[hash]" ) {
+    CHECK(hash64("", 0) == 0xEF46DB3751D8E999ULL);
+    CHECK(hash64("abc", 3) == 0x44BC2CF5AD770999ULL);
+
+    std::string text(urdfstr_full);
+    CHECK(UrdfModel::contentHash(text.data(), text.size()) == hash64(text.data(), text.size()));
+    text[text.size() / 2] ^= 1;
+    CHECK(UrdfModel::contentHash(text.data(), text.size()) != hash64(urdfstr_full, text.size()));
+}
+
+TEST_CASE ( "round trip a model through the binary format", "[UrdfModel]" ) {
+    std::string xml(urdfstr_full);
+    std::shared_ptr<UrdfModel> model;
+    REQUIRE_NOTHROW(model = UrdfModel::fromUrdfStr(xml));
+
+    uint64_t source_hash = UrdfModel::contentHash(xml.data(), xml.size());
+    std::string binary = model->toBinary(source_hash);
+    CHECK(binary.size() % 8 == 0);
+    // the output does not depend on anything but the model
+    CHECK(UrdfModel::fromUrdfStr(xml)->toBinary(source_hash) == binary);
+
+    uint64_t stored_hash = 0;
+    REQUIRE(UrdfModel::binarySourceHash(binary.data(), binary.size(), stored_hash));
+    CHECK(stored_hash == source_hash);
+
+    std::shared_ptr<UrdfModel> loaded;
+    REQUIRE_NOTHROW(loaded = UrdfModel::fromBinary(binary.data(), binary.size()));
+    CHECK(loaded->toBinary(source_hash) == binary);
+
+    CHECK(loaded->getName() == "full");
+    CHECK(loaded->link_map.size() == 3);
+    CHECK(loaded->joint_map.size() == 2);
+    CHECK(loaded->material_map.size() == 2);
+    REQUIRE(loaded->getRoot() != nullptr);
+    CHECK(loaded->getRoot()->name == "base");
+
+    auto blue = loaded->getMaterial("blue");
+    REQUIRE(blue != nullptr);
+    CHECK(blue->color.b == 0.8f);
+    CHECK(blue->texture_filename == "blue.png");
+
+    auto base = loaded->getLink("base");
+    REQUIRE(base->inertial.has_value());
+    CHECK(base->inertial->mass == 2.5);
+    CHECK(base->inertial->iyz == 0.3);
+    CHECK(base->inertial->origin.rotation.y == model->getLink("base")->inertial->origin.rotation.y);
+    REQUIRE(base->visuals.size() == 2);
+    CHECK(base->visuals[0]->name == "body");
+    CHECK(base->visuals[0]->origin.position.z == 3.);
+    CHECK(base->visuals[0]->material.value() == blue);
+    auto box = std::dynamic_pointer_cast<Box>(base->visuals[0]->geometry.value());
+    REQUIRE(box != nullptr);
+    CHECK(box->dim.y == 2.);
+    auto mesh = std::dynamic_pointer_cast<Mesh>(base->visuals[1]->geometry.value());
+    REQUIRE(mesh != nullptr);
+    CHECK(mesh->filename == "package://robot/base.stl");
+    CHECK(mesh->scale.z == 0.3);
+    CHECK(base->visuals[1]->material.value() == loaded->getMaterial("red"));
+    REQUIRE(base->collisions.size() == 2);
+    CHECK(std::dynamic_pointer_cast<Cylinder>(base->collisions[0]->geometry.value())->radius == 0.1);
+    CHECK(base->collisions[1]->name == "cap");
+    CHECK(std::dynamic_pointer_cast<Capsule>(base->collisions[1]->geometry.value())->length == 0.4);
+    CHECK_FALSE(loaded->getLink("finger")->inertial.has_value());
+
+    auto arm = loaded->getLink("arm");
+    CHECK(arm->getParent() == base);
+    CHECK(arm->parent_joint == loaded->getJoint("shoulder"));
+    REQUIRE(base->child_links.size() == 1);
+    CHECK(base->child_links[0] == arm);
+    CHECK(base->child_joints[0] == loaded->getJoint("shoulder"));
+
+    auto shoulder = loaded->getJoint("shoulder");
+    CHECK(shoulder->type == JointType::REVOLUTE);
+    CHECK(shoulder->parent_link_name == "base");
+    CHECK(shoulder->child_link_name == "arm");
+    CHECK(shoulder->axis.y == 1.);
+    CHECK(shoulder->parent_to_joint_transform.rotation.x ==
+          model->getJoint("shoulder")->parent_to_joint_transform.rotation.x);
+    CHECK(shoulder->limits.value()->upper == 1.);
+    CHECK(shoulder->safety.value()->k_velocity == 6.);
+    CHECK(shoulder->dynamics.value()->friction == 0.4);
+    CHECK(shoulder->calibration.value()->rising.value() == 0.25);
+    CHECK_FALSE(shoulder->calibration.value()->falling.has_value());
+    CHECK_FALSE(shoulder->mimic.has_value());
+
+    auto grip = loaded->getJoint("grip");
+    CHECK(grip->type == JointType::PRISMATIC);
+    CHECK_FALSE(grip->dynamics.has_value());
+    REQUIRE(grip->mimic.has_value());
+    CHECK(grip->mimic.value()->joint_name == "shoulder");
+    CHECK(grip->mimic.value()->multiplier == 2.);
+}
+
+TEST_CASE ( "binary models keep their cached origin matrices", "[UrdfModel]" ) {
+    ParseOptions options;
+    options.cache_origin_matrices = true;
+    std::string binary = UrdfModel::fromUrdfStr(std::string(urdfstr_full), options)->toBinary();
+    auto cached = UrdfModel::fromBinary(binary.data(), binary.size());
+    auto base = cached->getLink("base");
+    REQUIRE(base->visuals[0]->origin_matrix.has_value());
+    CHECK(base->visuals[0]->origin_matrix->m[3] == 1.);
+    CHECK(base->inertial->origin_matrix.has_value());
+    CHECK(cached->getJoint("shoulder")->parent_to_joint_matrix.has_value());
+
+    binary = UrdfModel::fromUrdfStr(std::string(urdfstr_full))->toBinary();
+    auto uncached = UrdfModel::fromBinary(binary.data(), binary.size());
+    CHECK_FALSE(uncached->getLink("base")->visuals[0]->origin_matrix.has_value());
+    CHECK_FALSE(uncached->getJoint("shoulder")->parent_to_joint_matrix.has_value());
+}
+
+TEST_CASE ( "reject damaged binary models", "[UrdfModel]" ) {
+    std::string binary = UrdfModel::fromUrdfStr(std::string(urdfstr_full))->toBinary();
+
+    std::string corrupted = binary;
+    corrupted[corrupted.size() / 2] ^= 0x10;
+    CHECK_THROWS_WITH(UrdfModel::fromBinary(corrupted.data(), corrupted.size()),
+                      Catch::Contains("corrupted"));
+
+    CHECK_THROWS_WITH(UrdfModel::fromBinary(binary.data(), binary.size() - 8),
+                      Catch::Contains("truncated"));
+
+    std::string other_version = binary;
+    other_version[8] = 2;
+    uint64_t hash;
+    CHECK_FALSE(UrdfModel::binarySourceHash(other_version.data(), other_version.size(), hash));
+    CHECK_THROWS_WITH(UrdfModel::fromBinary(other_version.data(), other_version.size()),
+                      Catch::Contains("version 2"));
+
+    // a joint type past FIXED, with the payload hash redone so only the type is wrong
+    std::string bad_joint = binary;
+    uint32_t joints_offset;
+    std::memcpy(&joints_offset, bad_joint.data() + 56 + 8 * 5, sizeof(joints_offset));
+    bad_joint[joints_offset + 224] = JointType::FIXED + 1;
+    uint64_t payload_hash = hash64(bad_joint.data() + 128, bad_joint.size() - 128);
+    std::memcpy(&bad_joint[24], &payload_hash, sizeof(payload_hash));
+    CHECK_THROWS_WITH(UrdfModel::fromBinary(bad_joint.data(), bad_joint.size()),
+                      Catch::Contains("unknown joint type"));
+
+    const char* xml = "<robot name=\"r\"><link name=\"a\"/></robot>";
+    CHECK_FALSE(UrdfModel::binarySourceHash(xml, std::strlen(xml), hash));
+    CHECK_THROWS_AS(UrdfModel::fromBinary(xml, std::strlen(xml)), URDFParseError);
+}
+
+TEST_CASE ( "load a binary model file through a memory mapping", "[UrdfModel]" ) {
+    std::string binary = UrdfModel::fromUrdfStr(std::string(urdfstr_full))->toBinary();
+
+    auto path = std::filesystem::temp_directory_path() / "urdfparser_test_model.urdfbin";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(binary.data(), binary.size());
+    }
+
+    std::shared_ptr<UrdfModel> model;
+    REQUIRE_NOTHROW(model = UrdfModel::fromBinaryFile(path.string()));
+    CHECK(model->getRoot()->name == "base");
+    CHECK(model->toBinary() == binary);
+
+    std::remove(path.string().c_str());
+}
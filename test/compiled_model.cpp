@@ -0,0 +1,104 @@
+#include "catch2/catch.hpp"
+#include "urdf/model.h"
+#include "urdf/compiled_model.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+static const char* urdfstr_tree =
+    "<robot name=\"tree\">\n"
+    "  <link name=\"torso\"/>\n"
+    "  <link name=\"left_hand\"/>\n"
+    "  <link name=\"left_arm\"/>\n"
+    "  <link name=\"right_arm\"/>\n"
+    "  <joint name=\"left_wrist\" type=\"revolute\">\n"
+    "    <parent link=\"left_arm\"/>\n"
+    "    <child link=\"left_hand\"/>\n"
+    "    <axis xyz=\"0 1 0\"/>\n"
+    "    <limit effort=\"1\" velocity=\"1\"/>\n"
+    "  </joint>\n"
+    "  <joint name=\"right_shoulder\" type=\"prismatic\">\n"
+    "    <parent link=\"torso\"/>\n"
+    "    <child link=\"right_arm\"/>\n"
+    "    <origin xyz=\"0 -0.2 0\"/>\n"
+    "    <limit effort=\"1\" velocity=\"1\"/>\n"
+    "  </joint>\n"
+    "  <joint name=\"left_shoulder\" type=\"fixed\">\n"
+    "    <parent link=\"torso\"/>\n"
+    "    <child link=\"left_arm\"/>\n"
+    "    <origin xyz=\"0 0.2 0\"/>\n"
+    "  </joint>\n"
+    "</robot>";
+
+using namespace urdf;
+
+TEST_CASE ( "compile a model into topologically ordered arrays", "[CompiledModel]" ) {
+    std::shared_ptr<UrdfModel> model;
+    REQUIRE_NOTHROW(model = UrdfModel::fromUrdfStr(std::string(urdfstr_tree)));
+
+    std::shared_ptr<CompiledModel> compiled;
+    REQUIRE_NOTHROW(compiled = CompiledModel::fromUrdfModel(*model));
+
+    REQUIRE(compiled->numLinks() == 4);
+    REQUIRE(compiled->numJoints() == 3);
+    CHECK(compiled->links[0] == model->getRoot());
+    CHECK(compiled->link_parent[0] == -1);
+    CHECK(compiled->link_parent_joint[0] == -1);
+
+    for (size_t i = 0; i < compiled->numLinks(); i++) {
+        // compiling only reads the model
+        CHECK(compiled->links[i]->link_index == -1);
+        // parents always come before their children
+        CHECK(compiled->link_parent[i] < (int) i);
+    }
+
+    for (size_t j = 0; j < compiled->numJoints(); j++) {
+        auto joint = compiled->joints[j];
+        CHECK(compiled->joint_child_link[j] == (int) j + 1);
+        CHECK(compiled->link_parent_joint[j + 1] == (int) j);
+        CHECK(compiled->links[compiled->joint_child_link[j]]->name == joint->child_link_name);
+        CHECK(compiled->links[compiled->joint_parent_link[j]]->name == joint->parent_link_name);
+        CHECK(compiled->joint_type[j] == joint->type);
+        CHECK(compiled->joint_axis[j].y == joint->axis.y);
+        CHECK(compiled->joint_origin[j].position.y == joint->parent_to_joint_transform.position.y);
+    }
+
+    REQUIRE_NOTHROW(compiled = model->assignIndices());
+    for (size_t i = 0; i < compiled->numLinks(); i++) {
+        CHECK(compiled->links[i]->link_index == (int) i);
+    }
+    for (size_t j = 0; j < compiled->numJoints(); j++) {
+        CHECK(compiled->joints[j]->joint_index == (int) j);
+    }
+
+    auto left_hand = model->getLink("left_hand");
+    auto left_arm = model->getLink("left_arm");
+    CHECK(compiled->link_parent[left_hand->link_index] == left_arm->link_index);
+    CHECK(compiled->joint_type[model->getJoint("left_wrist")->joint_index] == JointType::REVOLUTE);
+}
+
+TEST_CASE ( "threads can compile the same model at once", "[CompiledModel]" ) {
+    std::shared_ptr<const UrdfModel> model = UrdfModel::fromUrdfStr(std::string(urdfstr_tree));
+    std::shared_ptr<CompiledModel> expected = CompiledModel::fromUrdfModel(*model);
+
+    std::vector<std::shared_ptr<CompiledModel>> compiled(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < compiled.size(); t++) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 1000; i++) {
+                compiled[t] = CompiledModel::fromUrdfModel(*model);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto& result : compiled) {
+        CHECK(result->links == expected->links);
+        CHECK(result->link_parent == expected->link_parent);
+        CHECK(result->joints == expected->joints);
+    }
+    CHECK(model->getRoot()->link_index == -1);
+}
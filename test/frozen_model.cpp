@@ -0,0 +1,120 @@
+#include "catch2/catch.hpp"
+#include "urdf/frozen_model.h"
+#include "urdf/kinematics.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+static const char* urdfstr_arm =
+    "<robot name=\"arm\">\n"
+    "  <material name=\"grey\"><color rgba=\"0.5 0.5 0.5 1\"/></material>\n"
+    "  <link name=\"base\">\n"
+    "    <visual><origin xyz=\"0 0 1\"/><geometry><box size=\"1 2 3\"/></geometry><material name=\"grey\"/></visual>\n"
+    "    <collision><geometry><mesh filename=\"base.stl\"/></geometry></collision>\n"
+    "  </link>\n"
+    "  <link name=\"upper\"><visual><geometry><sphere radius=\"1\"/></geometry><material name=\"grey\"/></visual></link>\n"
+    "  <link name=\"lower\"/>\n"
+    "  <joint name=\"shoulder\" type=\"revolute\">\n"
+    "    <parent link=\"base\"/><child link=\"upper\"/><origin xyz=\"0 0 1\"/><axis xyz=\"0 1 0\"/>\n"
+    "    <limit effort=\"1\" velocity=\"1\" lower=\"-1\" upper=\"1\"/>\n"
+    "  </joint>\n"
+    "  <joint name=\"elbow\" type=\"revolute\">\n"
+    "    <parent link=\"upper\"/><child link=\"lower\"/><origin xyz=\"0 0 1\"/><axis xyz=\"0 1 0\"/>\n"
+    "    <limit effort=\"1\" velocity=\"1\" lower=\"-1\" upper=\"1\"/>\n"
+    "  </joint>\n"
+    "</robot>";
+
+using namespace urdf;
+
+TEST_CASE ( "a frozen model is an independent snapshot", "[FrozenModel]" ) {
+    std::shared_ptr<UrdfModel> model = UrdfModel::fromUrdfStr(std::string(urdfstr_arm));
+    std::shared_ptr<const FrozenModel> frozen;
+    REQUIRE_NOTHROW(frozen = model->freeze());
+
+    CHECK(frozen->getName() == "arm");
+    REQUIRE(frozen->getRoot() != nullptr);
+    CHECK(frozen->getRoot()->name == "base");
+    CHECK(frozen->numLinks() == 3);
+    CHECK(frozen->numJoints() == 2);
+    CHECK(frozen->getLink("missing") == nullptr);
+
+    const LinkValue* lower = frozen->getLink("lower");
+    REQUIRE(lower != nullptr);
+    CHECK(frozen->linkAt(frozen->linkIndex("lower")) == lower);
+    CHECK(frozen->getParentLink(*lower) == frozen->getLink("upper"));
+    CHECK(frozen->getParentJoint(*lower) == frozen->getJoint("elbow"));
+    CHECK(frozen->getParentLink(*frozen->getRoot()) == nullptr);
+    REQUIRE(frozen->getRoot()->child_links.size() == 1);
+    CHECK(frozen->linkAt(frozen->getRoot()->child_links[0]) == frozen->getLink("upper"));
+
+    // the tree is kept as indices, the links and joints of the model are not
+    CHECK(frozen->getCompiledModel().numLinks() == 3);
+    CHECK(frozen->getCompiledModel().links.empty());
+    CHECK(frozen->getCompiledModel().joints.empty());
+
+    // materials shared inside the model stay shared
+    const VisualValue& visual = frozen->getLink("base")->visuals[0];
+    CHECK(frozen->getMaterial(visual) == frozen->getMaterial("grey"));
+    CHECK(frozen->getMaterial(frozen->getLink("upper")->visuals[0]) == frozen->getMaterial("grey"));
+
+    model->getMaterial("grey")->color.r = 1.f;
+    model->getJoint("shoulder")->limits.value()->upper = 5.;
+    std::static_pointer_cast<Box>(model->getLink("base")->visuals[0]->geometry.value())->dim.x = 7.;
+    model->link_map.erase("lower");
+    model.reset();
+    CHECK(frozen->getMaterial("grey")->color.r == 0.5f);
+    CHECK(frozen->getJoint("shoulder")->limits->upper == 1.);
+    CHECK(std::get<Box>(visual.geometry.value()).dim.x == 1.);
+    CHECK(frozen->getLink("lower") == lower);
+}
+
+TEST_CASE ( "a frozen model can be read by many threads", "[FrozenModel]" ) {
+    std::shared_ptr<const FrozenModel> frozen = UrdfModel::fromUrdfStr(std::string(urdfstr_arm))->freeze();
+
+    std::vector<double> tips(8);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < tips.size(); t++) {
+        threads.emplace_back([&, t]() {
+            const CompiledModel& compiled = frozen->getCompiledModel();
+            std::vector<double> q(compiled.numPositions(), 0.);
+            std::vector<Transform> poses(compiled.numLinks());
+            for (int i = 0; i < 1000; i++) {
+                int lower = frozen->linkIndex("lower");
+                forwardKinematics(compiled, q.data(), poses.data());
+                tips[t] = poses[lower].position.z;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (double tip : tips) {
+        CHECK(tip == Approx(2.));
+    }
+}
+
+TEST_CASE ( "the name index finds every name and nothing else", "[FrozenModel]" ) {
+    std::vector<std::string> names;
+    for (int i = 0; i < 2000; i++) {
+        names.push_back("joint_" + std::to_string(i));
+    }
+    names.push_back("");
+    NameIndex index(names);
+    CHECK(index.size() == names.size());
+    for (size_t i = 0; i < names.size(); i++) {
+        CHECK(index.find(names[i]) == static_cast<int>(i));
+    }
+    CHECK(index.find("joint_2000") == -1);
+    CHECK(index.find("joint_") == -1);
+    CHECK(NameIndex().find("joint_0") == -1);
+
+    std::shared_ptr<const FrozenModel> frozen = UrdfModel::fromUrdfStr(std::string(urdfstr_arm))->freeze();
+    int elbow = frozen->jointIndex("elbow");
+    REQUIRE(elbow >= 0);
+    CHECK(frozen->jointAt(elbow)->name == "elbow");
+    CHECK(frozen->linkAt(frozen->linkIndex("lower")) == frozen->getLink("lower"));
+    CHECK(frozen->materialAt(frozen->materialIndex("grey"))->color.g == 0.5f);
+    CHECK(frozen->jointIndex("wrist") == -1);
+    CHECK(frozen->getJoint(std::string_view("elbow_joint", 5)) == frozen->jointAt(elbow));
+}
@@ -0,0 +1,144 @@
+#include "catch2/catch.hpp"
+#include "urdf/model.h"
+#include "urdf/compiled_model.h"
+#include "urdf/kinematics.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static const char* urdfstr_all_joints =
+    "<robot name=\"joints\">\n"
+    "  <link name=\"base\"/>\n"
+    "  <link name=\"arm\"/>\n"
+    "  <link name=\"slider\"/>\n"
+    "  <link name=\"tool\"/>\n"
+    "  <link name=\"cart\"/>\n"
+    "  <link name=\"drone\"/>\n"
+    "  <joint name=\"shoulder\" type=\"revolute\">\n"
+    "    <parent link=\"base\"/><child link=\"arm\"/>\n"
+    "    <origin xyz=\"0 0 1\"/><axis xyz=\"0 0 1\"/>\n"
+    "    <limit effort=\"1\" velocity=\"1\" lower=\"-3\" upper=\"3\"/>\n"
+    "  </joint>\n"
+    "  <joint name=\"extend\" type=\"prismatic\">\n"
+    "    <parent link=\"arm\"/><child link=\"slider\"/>\n"
+    "    <origin xyz=\"1 0 0\"/><axis xyz=\"2 0 0\"/>\n"
+    "    <limit effort=\"1\" velocity=\"1\" lower=\"0\" upper=\"1\"/>\n"
+    "  </joint>\n"
+    "  <joint name=\"flange\" type=\"fixed\">\n"
+    "    <parent link=\"slider\"/><child link=\"tool\"/>\n"
+    "    <origin xyz=\"0 0 -0.5\" rpy=\"0 0 1.5707963267948966\"/>\n"
+    "  </joint>\n"
+    "  <joint name=\"floor\" type=\"planar\">\n"
+    "    <parent link=\"base\"/><child link=\"cart\"/>\n"
+    "    <axis xyz=\"0 0 1\"/>\n"
+    "  </joint>\n"
+    "  <joint name=\"air\" type=\"floating\">\n"
+    "    <parent link=\"base\"/><child link=\"drone\"/>\n"
+    "  </joint>\n"
+    "</robot>";
+
+using namespace urdf;
+
+static const Transform& poseOf(const std::vector<Transform>& poses, const UrdfModel& model, const char* link) {
+    return poses[model.link_map.at(link)->link_index];
+}
+
+TEST_CASE ( "forward kinematics for every joint type", "[kinematics]" ) {
+    std::shared_ptr<UrdfModel> model;
+    REQUIRE_NOTHROW(model = UrdfModel::fromUrdfStr(std::string(urdfstr_all_joints)));
+    std::shared_ptr<CompiledModel> compiled = model->assignIndices();
+
+    // revolute 1 + prismatic 1 + fixed 0 + planar 3 + floating 7
+    REQUIRE(compiled->numPositions() == 12);
+
+    std::vector<double> q(compiled->numPositions(), 0.);
+    q[compiled->joint_position_index[model->getJoint("shoulder")->joint_index]] = M_PI / 2;
+    q[compiled->joint_position_index[model->getJoint("extend")->joint_index]] = 0.5;
+    int planar = compiled->joint_position_index[model->getJoint("floor")->joint_index];
+    q[planar] = 2.;
+    q[planar + 1] = 3.;
+    q[planar + 2] = M_PI;
+    int floating = compiled->joint_position_index[model->getJoint("air")->joint_index];
+    double floating_q[7] = { 1., 2., 3., 0., 0., std::sin(M_PI / 4), std::cos(M_PI / 4) };
+    std::copy(floating_q, floating_q + 7, q.begin() + floating);
+
+    std::vector<Transform> poses;
+    REQUIRE_NOTHROW(poses = forwardKinematics(*compiled, q));
+    REQUIRE(poses.size() == compiled->numLinks());
+
+    const Transform& base = poseOf(poses, *model, "base");
+    CHECK(base.position.x == 0.);
+    CHECK(base.rotation.w == 1.);
+
+    // the arm turns a quarter around z, so its x axis points along world y
+    const Transform& arm = poseOf(poses, *model, "arm");
+    CHECK(arm.position.z == Approx(1.));
+    Vector3 arm_x = arm.rotation * Vector3(1., 0., 0.);
+    CHECK(arm_x.y == Approx(1.));
+
+    // the slider moves along its unit length axis in the turned frame
+    const Transform& slider = poseOf(poses, *model, "slider");
+    CHECK(slider.position.x == Approx(0.).margin(1e-12));
+    CHECK(slider.position.y == Approx(1.5));
+    CHECK(slider.position.z == Approx(1.));
+
+    const Transform& tool = poseOf(poses, *model, "tool");
+    CHECK(tool.position.y == Approx(1.5));
+    CHECK(tool.position.z == Approx(0.5));
+    Vector3 tool_x = tool.rotation * Vector3(1., 0., 0.);
+    CHECK(tool_x.x == Approx(-1.));
+
+    const Transform& cart = poseOf(poses, *model, "cart");
+    CHECK(cart.position.x == Approx(2.));
+    CHECK(cart.position.y == Approx(3.));
+    CHECK(cart.position.z == Approx(0.).margin(1e-12));
+    CHECK(std::fabs(cart.rotation.z) == Approx(1.));
+
+    const Transform& drone = poseOf(poses, *model, "drone");
+    CHECK(drone.position.z == Approx(3.));
+    CHECK(drone.rotation.z == Approx(std::sin(M_PI / 4)));
+
+    // a floating joint quaternion that is not unit length still gives a rotation
+    q[floating + 5] *= 3.;
+    q[floating + 6] *= 3.;
+    REQUIRE_NOTHROW(poses = forwardKinematics(*compiled, q));
+    const Transform& scaled_drone = poseOf(poses, *model, "drone");
+    CHECK(scaled_drone.rotation.z == Approx(std::sin(M_PI / 4)));
+    CHECK(scaled_drone.rotation.w == Approx(std::cos(M_PI / 4)));
+    Vector3 drone_x = scaled_drone.rotation * Vector3(1., 0., 0.);
+    CHECK(drone_x.y == Approx(1.));
+    CHECK(drone_x.x == Approx(0.).margin(1e-12));
+
+    CHECK_THROWS_AS(forwardKinematics(*compiled, std::vector<double>(3, 0.)), std::invalid_argument);
+}
+
+TEST_CASE ( "batched forward kinematics matches single configurations", "[kinematics]" ) {
+    auto model = UrdfModel::fromUrdfStr(std::string(urdfstr_all_joints));
+    auto compiled = CompiledModel::fromUrdfModel(*model);
+
+    const size_t num_configurations = 16;
+    size_t num_positions = compiled->numPositions();
+    size_t num_links = compiled->numLinks();
+
+    std::vector<double> q(num_configurations * num_positions);
+    for (size_t i = 0; i < q.size(); i++) {
+        q[i] = std::sin(0.37 * i);
+    }
+
+    std::vector<Transform> batch(num_configurations * num_links);
+    forwardKinematics(*compiled, q.data(), num_configurations, batch.data());
+
+    for (size_t c = 0; c < num_configurations; c++) {
+        std::vector<double> single_q(q.begin() + c * num_positions, q.begin() + (c + 1) * num_positions);
+        std::vector<Transform> single = forwardKinematics(*compiled, single_q);
+        for (size_t l = 0; l < num_links; l++) {
+            const Transform& pose = batch[c * num_links + l];
+            CHECK(pose.position.x == single[l].position.x);
+            CHECK(pose.position.y == single[l].position.y);
+            CHECK(pose.position.z == single[l].position.z);
+            CHECK(pose.rotation.w == single[l].rotation.w);
+        }
+    }
+}
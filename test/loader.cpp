@@ -0,0 +1,116 @@
+#include "catch2/catch.hpp"
+#include "urdf/loader.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace urdf;
+
+static std::string robotWithLinks(int num_links, const char* color) {
+    std::string xml = "<robot name=\"robot_" + std::to_string(num_links) + "\">"
+                      "<material name=\"paint\"><color rgba=\"" + std::string(color) + "\"/></material>";
+    for (int i = 0; i < num_links; i++) {
+        xml += "<link name=\"l" + std::to_string(i) + "\"><visual><geometry><sphere radius=\"1\"/></geometry>"
+               "<material name=\"paint\"/></visual></link>";
+        if (i > 0) {
+            xml += "<joint name=\"j" + std::to_string(i) + "\" type=\"fixed\"><parent link=\"l" + std::to_string(i - 1) +
+                   "\"/><child link=\"l" + std::to_string(i) + "\"/></joint>";
+        }
+    }
+    return xml + "</robot>";
+}
+
+TEST_CASE ( "load many documents concurrently", "[UrdfLoader]" ) {
+    LoaderOptions options;
+    options.num_threads = 4;
+    UrdfLoader loader(options);
+    CHECK(loader.numThreads() == 4);
+
+    std::vector<std::string> documents;
+    for (int i = 1; i <= 40; i++) {
+        documents.push_back(robotWithLinks(i, i % 2 ? "1 0 0 1" : "0 0 1 1"));
+    }
+    documents.push_back("<robot name=\"broken\"><link name=\"a\"/><link name=\"a\"/></robot>");
+
+    auto path = std::filesystem::temp_directory_path() / "urdfparser_test_loader.urdf";
+    {
+        std::ofstream out(path);
+        out << robotWithLinks(3, "1 0 0 1");
+    }
+
+    auto models = loader.loadStrings(documents);
+    auto from_file = loader.loadFile(path.string());
+    REQUIRE(models.size() == documents.size());
+
+    for (int i = 1; i <= 40; i++) {
+        std::shared_ptr<UrdfModel> model;
+        REQUIRE_NOTHROW(model = models[i - 1].get());
+        CHECK(model->getName() == "robot_" + std::to_string(i));
+        CHECK(model->link_map.size() == static_cast<size_t>(i));
+        CHECK(model->getLink("l0")->visuals[0]->material.value() == model->getMaterial("paint"));
+    }
+    CHECK_THROWS_WITH(models.back().get(), Catch::Contains("Duplicate links"));
+    std::shared_ptr<UrdfModel> file_model = from_file.get();
+    CHECK(file_model->getName() == "robot_3");
+
+    std::vector<LoadTiming> timings = loader.timings();
+    REQUIRE(timings.size() == documents.size() + 1);
+    CHECK(timings[0].source == "string 0");
+    CHECK(timings[0].bytes == documents[0].size());
+    CHECK(timings[0].succeeded);
+    CHECK(timings[0].parse_seconds > 0.);
+    CHECK_FALSE(timings[40].succeeded);
+    CHECK(timings[41].source == path.string());
+    CHECK(timings[41].bytes == std::filesystem::file_size(path));
+
+    // taking the timings hands them out once
+    CHECK(loader.takeTimings().size() == documents.size() + 1);
+    CHECK(loader.timings().empty());
+    loader.loadString(documents[0]).get();
+    timings = loader.takeTimings();
+    REQUIRE(timings.size() == 1);
+    CHECK(timings[0].source == "string 41");
+    CHECK(loader.takeTimings().empty());
+
+    std::remove(path.string().c_str());
+}
+
+TEST_CASE ( "frozen models share identical materials", "[UrdfLoader]" ) {
+    UrdfLoader loader;
+    auto red_1 = loader.loadFrozenString(robotWithLinks(2, "1 0 0 1")).get();
+    auto red_2 = loader.loadFrozenString(robotWithLinks(3, "1 0 0 1")).get();
+    auto blue = loader.loadFrozenString(robotWithLinks(2, "0 0 1 1")).get();
+
+    CHECK(red_1->getMaterial("paint") == red_2->getMaterial("paint"));
+    CHECK(red_2->getMaterial(red_2->getLink("l2")->visuals[0]) == red_1->getMaterial("paint"));
+    CHECK(blue->getMaterial("paint") != red_1->getMaterial("paint"));
+    CHECK(blue->getMaterial("paint")->color.b == 1.f);
+    CHECK(loader.numMaterialTables() == 2);
+
+    // a table goes away with the last model using it
+    red_1.reset();
+    CHECK(loader.numMaterialTables() == 2);
+    red_2.reset();
+    blue.reset();
+    CHECK(loader.numMaterialTables() == 0);
+
+    CHECK_THROWS_WITH(loader.loadFrozenString("<robot name=\"broken\"><link name=\"a\"/><link name=\"a\"/></robot>").get(),
+                      Catch::Contains("Duplicate links"));
+
+    // models that can be modified share nothing
+    auto a = loader.loadString(robotWithLinks(2, "1 0 0 1")).get();
+    auto b = loader.loadString(robotWithLinks(2, "1 0 0 1")).get();
+    CHECK(a->getMaterial("paint") != b->getMaterial("paint"));
+    CHECK(loader.numMaterialTables() == 0);
+
+    LoaderOptions options;
+    options.share_materials = false;
+    UrdfLoader separate(options);
+    auto frozen_models = separate.loadFrozenStrings({ robotWithLinks(2, "1 0 0 1"), robotWithLinks(2, "1 0 0 1") });
+    auto c = frozen_models[0].get();
+    auto d = frozen_models[1].get();
+    CHECK(c->getMaterial("paint") != d->getMaterial("paint"));
+}
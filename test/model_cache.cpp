@@ -0,0 +1,89 @@
+#include "catch2/catch.hpp"
+#include "urdf/model_cache.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace urdf;
+
+static std::string robotNamed(const std::string& name) {
+    return "<robot name=\"" + name + "\"><link name=\"base\"/><link name=\"tool\"/>"
+           "<joint name=\"j\" type=\"fixed\"><parent link=\"base\"/><child link=\"tool\"/></joint></robot>";
+}
+
+TEST_CASE ( "the model cache returns the same model for the same document", "[ModelCache]" ) {
+    ModelCache cache(1 << 20);
+    std::string xml = robotNamed("a");
+
+    std::shared_ptr<const FrozenModel> first = cache.fromUrdfStr(xml);
+    std::shared_ptr<const FrozenModel> second = cache.fromUrdfStr(std::string(xml));
+    CHECK(first == second);
+    CHECK(first->getName() == "a");
+    CHECK(first->getParentLink(*first->getLink("tool")) == first->getRoot());
+    CHECK(cache.fromUrdfBuffer(xml.data(), xml.size()) == first);
+
+    std::shared_ptr<const FrozenModel> other = cache.fromUrdfStr(robotNamed("b"));
+    CHECK(other != first);
+    CHECK(other->getName() == "b");
+
+    ModelCache::Statistics statistics = cache.statistics();
+    CHECK(statistics.hits == 2);
+    CHECK(statistics.misses == 2);
+    CHECK(statistics.entries == 2);
+    // the document copies and the models are charged
+    CHECK(statistics.bytes == xml.size() + first->memoryUsage() + robotNamed("b").size() + other->memoryUsage());
+    CHECK(first->memoryUsage() > sizeof(FrozenModel));
+
+    // errors are thrown every time and not cached
+    CHECK_THROWS_AS(cache.fromUrdfStr("<robot name=\"x\"/>"), URDFParseError);
+    CHECK_THROWS_AS(cache.fromUrdfStr("<robot name=\"x\"/>"), URDFParseError);
+    CHECK(cache.statistics().entries == 2);
+    CHECK(cache.statistics().misses == 4);
+}
+
+TEST_CASE ( "the model cache evicts the least recently used models", "[ModelCache]" ) {
+    // room for two of the equally large entries
+    size_t size = robotNamed("a").size() + UrdfModel::fromUrdfStr(robotNamed("a"))->freeze()->memoryUsage();
+    ModelCache cache(2 * size);
+
+    auto a = cache.fromUrdfStr(robotNamed("a"));
+    auto b = cache.fromUrdfStr(robotNamed("b"));
+    CHECK(cache.fromUrdfStr(robotNamed("a")) == a);  // a is now more recent than b
+    auto c = cache.fromUrdfStr(robotNamed("c"));
+
+    ModelCache::Statistics statistics = cache.statistics();
+    CHECK(statistics.evictions == 1);
+    CHECK(statistics.entries == 2);
+    CHECK(statistics.bytes <= cache.byteBudget());
+
+    CHECK(cache.fromUrdfStr(robotNamed("a")) == a);
+    CHECK(cache.fromUrdfStr(robotNamed("c")) == c);
+    // b was dropped and is parsed again, while the old model stays valid
+    CHECK(cache.fromUrdfStr(robotNamed("b")) != b);
+    CHECK(b->getName() == "b");
+
+    cache.clear();
+    CHECK(cache.statistics().entries == 0);
+    CHECK(cache.statistics().bytes == 0);
+}
+
+TEST_CASE ( "the model cache parses a document once for concurrent callers", "[ModelCache]" ) {
+    ModelCache cache(1 << 20);
+    std::string xml = robotNamed("shared");
+
+    std::vector<std::shared_ptr<const FrozenModel>> models(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < models.size(); i++) {
+        threads.emplace_back([&, i]() { models[i] = cache.fromUrdfStr(xml); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto& model : models) {
+        CHECK(model == models[0]);
+    }
+    CHECK(cache.statistics().misses == 1);
+    CHECK(cache.statistics().hits == 7);
+}
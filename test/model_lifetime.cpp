@@ -0,0 +1,65 @@
+#include "catch2/catch.hpp"
+#include "urdf/model.h"
+#include "urdf/allocations.h"
+
+#include <string>
+
+static const char* urdfstr_chain =
+    "<robot name=\"chain\">\n"
+    "  <link name=\"base\"/>\n"
+    "  <link name=\"upper\">\n"
+    "    <visual><geometry><box size=\"0.1 0.1 0.5\"/></geometry></visual>\n"
+    "  </link>\n"
+    "  <link name=\"lower\">\n"
+    "    <collision><geometry><cylinder length=\"0.4\" radius=\"0.05\"/></geometry></collision>\n"
+    "  </link>\n"
+    "  <joint name=\"shoulder\" type=\"revolute\">\n"
+    "    <parent link=\"base\"/>\n"
+    "    <child link=\"upper\"/>\n"
+    "    <limit effort=\"10\" velocity=\"1\" lower=\"-1\" upper=\"1\"/>\n"
+    "  </joint>\n"
+    "  <joint name=\"elbow\" type=\"continuous\">\n"
+    "    <parent link=\"upper\"/>\n"
+    "    <child link=\"lower\"/>\n"
+    "    <origin xyz=\"0 0 0.5\"/>\n"
+    "  </joint>\n"
+    "</robot>";
+
+using namespace urdf;
+
+TEST_CASE ( "links are released together with their model", "[UrdfModel]" ) {
+    std::weak_ptr<Link> root;
+    std::weak_ptr<Link> leaf;
+
+    {
+        auto model = UrdfModel::fromUrdfStr(urdfstr_chain);
+        root = model->getRoot();
+        leaf = model->getLink("lower");
+
+        REQUIRE(leaf.lock()->getParent() != nullptr);
+        CHECK(leaf.lock()->getParent()->name == "upper");
+        CHECK(leaf.lock()->getParent()->getParent() == root.lock());
+    }
+
+    CHECK(root.expired());
+    CHECK(leaf.expired());
+}
+
+TEST_CASE ( "building and destroying many models does not leak", "[UrdfModel]" ) {
+    const std::string xml_string(urdfstr_chain);
+
+    // warm up, so lazily initialized library state does not count as a leak
+    UrdfModel::fromUrdfStr(xml_string);
+
+    // destroying a model returns everything that was allocated while building it
+    REQUIRE(AllocationTracker::hooked());
+    AllocationTracker tracker;
+    for (int i = 0; i < 10000; i++) {
+        auto model = UrdfModel::fromUrdfStr(xml_string);
+    }
+    AllocationReport report = tracker.report();
+
+    CHECK(report.total().allocations > 0);
+    CHECK(report.live_blocks == 0);
+    CHECK(report.live_bytes == 0);
+}
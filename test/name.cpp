@@ -0,0 +1,116 @@
+#include "catch2/catch.hpp"
+#include "urdf/model.h"
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace urdf;
+
+TEST_CASE ( "equal names share one interned string", "[Name]" ) {
+    std::string text = "a_rather_long_name_for_a_link_of_a_robot";
+    Name a(text);
+    Name b(text.c_str());
+    Name c(std::string_view(text).substr(0, 10));
+    CHECK(a == b);
+    CHECK(a.id() == b.id());
+    CHECK(&a.str() == &b.str());
+    CHECK(a != c);
+    CHECK(c == "a_rather_l");
+    CHECK(a == text);
+    CHECK(c < a);
+    CHECK(std::string(a) == text);
+
+    Name empty;
+    CHECK(empty.empty());
+    CHECK(empty == Name(""));
+    a.clear();
+    CHECK(a == empty);
+
+    std::ostringstream out;
+    out << b;
+    CHECK(out.str() == text);
+    CHECK("[" + c + "]" == "[a_rather_l]");
+}
+
+TEST_CASE ( "names interned by many threads agree", "[Name]" ) {
+    std::vector<std::vector<Name>> names(8);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < names.size(); t++) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 500; i++) {
+                names[t].push_back(Name("threaded_name_" + std::to_string(i)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t t = 1; t < names.size(); t++) {
+        CHECK(names[t] == names[0]);
+    }
+}
+
+TEST_CASE ( "names created and dropped by many threads at once stay consistent", "[Name]" ) {
+    size_t pool_size = Name::poolSize();
+    std::atomic<int> mismatches(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 2000; i++) {
+                std::string text = "churned_name_" + std::to_string(i % 7);
+                Name name(text);
+                Name copy = name;
+                if (copy != text || copy != Name(text)) {
+                    mismatches++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    CHECK(mismatches == 0);
+    CHECK(Name::poolSize() == pool_size);
+}
+
+TEST_CASE ( "model names are interned", "[Name]" ) {
+    auto model = UrdfModel::fromUrdfStr(
+        "<robot name=\"r\"><link name=\"interned_base\"/><link name=\"interned_tool\"/>"
+        "<joint name=\"j\" type=\"fixed\"><parent link=\"interned_base\"/><child link=\"interned_tool\"/></joint></robot>");
+
+    auto joint = model->getJoint("j");
+    CHECK(joint->parent_link_name.id() == model->getLink("interned_base")->name.id());
+    CHECK(joint->child_link_name.id() == model->link_map.find("interned_tool")->first.id());
+
+    // looking up a missing name does not add it to the pool
+    size_t pool_size = Name::poolSize();
+    CHECK(model->getLink("a_name_that_was_never_seen_before") == nullptr);
+    CHECK(model->link_map.find(std::string("another_unknown_name")) == model->link_map.end());
+    CHECK(Name::poolSize() == pool_size);
+}
+
+TEST_CASE ( "names are dropped from the pool with the last model using them", "[Name]" ) {
+    const std::string xml =
+        "<robot name=\"r\"><link name=\"pooled_base\"/><link name=\"pooled_tool\"/>"
+        "<joint name=\"pooled_joint\" type=\"fixed\"><parent link=\"pooled_base\"/><child link=\"pooled_tool\"/></joint></robot>";
+    size_t pool_size = Name::poolSize();
+
+    auto model = UrdfModel::fromUrdfStr(xml);
+    auto other = UrdfModel::fromUrdfStr(xml);
+    CHECK(Name::poolSize() == pool_size + 3);
+    CHECK(other->getLink("pooled_base")->name.id() == model->getLink("pooled_base")->name.id());
+
+    model.reset();
+    CHECK(Name::poolSize() == pool_size + 3);
+    Name kept = other->getJoint("pooled_joint")->name;
+    other.reset();
+    CHECK(Name::poolSize() == pool_size + 1);
+    CHECK(kept == "pooled_joint");
+    kept = Name("pooled_base");
+    CHECK(Name::poolSize() == pool_size + 1);
+    kept.clear();
+    CHECK(Name::poolSize() == pool_size);
+}
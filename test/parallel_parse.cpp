@@ -0,0 +1,113 @@
+#include "catch2/catch.hpp"
+#include "urdf/model.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace urdf;
+
+// A tree of num_links links, every link hanging off link (i - 1) / 3.
+static std::string wideTreeRobot(int num_links) {
+    std::ostringstream xml;
+    xml << "<robot name=\"tree\">\n"
+        << "  <material name=\"grey\"><color rgba=\"0.5 0.5 0.5 1\"/></material>\n";
+    for (int i = 0; i < num_links; i++) {
+        xml << "  <link name=\"link_" << i << "\">\n"
+            << "    <inertial><mass value=\"" << 1 + i << "\"/>"
+            << "<inertia ixx=\"1\" ixy=\"0\" ixz=\"0\" iyy=\"1\" iyz=\"0\" izz=\"1\"/></inertial>\n"
+            << "    <visual><geometry><box size=\"1 1 " << i << "\"/></geometry><material name=\"grey\"/></visual>\n"
+            << "  </link>\n";
+        if (i > 0) {
+            xml << "  <joint name=\"joint_" << i << "\" type=\"revolute\">\n"
+                << "    <parent link=\"link_" << (i - 1) / 3 << "\"/><child link=\"link_" << i << "\"/>\n"
+                << "    <origin xyz=\"0 0 " << i << "\"/><axis xyz=\"0 0 1\"/>\n"
+                << "    <limit effort=\"1\" velocity=\"1\" lower=\"-1\" upper=\"1\"/>\n"
+                << "  </joint>\n";
+        }
+    }
+    xml << "</robot>\n";
+    return xml.str();
+}
+
+static ParseOptions threads(unsigned int num_threads) {
+    ParseOptions options;
+    options.num_threads = num_threads;
+    return options;
+}
+
+TEST_CASE ( "parsing on several threads builds the same model", "[UrdfModel]" ) {
+    std::string xml = wideTreeRobot(1000);
+    std::string serial = UrdfModel::fromUrdfStr(xml)->toBinary();
+
+    for (unsigned int num_threads : { 2u, 4u, 0u }) {
+        std::shared_ptr<UrdfModel> model;
+        REQUIRE_NOTHROW(model = UrdfModel::fromUrdfStr(xml, threads(num_threads)));
+        CHECK(model->link_map.size() == 1000);
+        CHECK(model->getRoot()->name == "link_0");
+        CHECK(model->getLink("link_7")->visuals[0]->material.value() == model->getMaterial("grey"));
+        CHECK(model->toBinary() == serial);
+    }
+}
+
+TEST_CASE ( "parsing on several threads reports the first error in the document", "[UrdfModel]" ) {
+    std::string xml = wideTreeRobot(400);
+    // break a joint early in the document and a link far behind it
+    size_t joint = xml.find("type=\"revolute\"", xml.find("name=\"joint_20\""));
+    xml.replace(joint, 15, "type=\"wobbly\"");
+    size_t link = xml.find("<mass value=", xml.find("name=\"link_390\""));
+    xml.replace(link, 12, "<mass weight=");
+
+    int serial_offset = -1;
+    std::string serial_message;
+    try {
+        UrdfModel::fromUrdfStr(xml);
+    } catch (const URDFParseError& e) {
+        serial_offset = e.byteOffset();
+        serial_message = e.what();
+    }
+    // links are added before joints, so the link wins in both cases
+    REQUIRE(serial_offset == static_cast<int>(xml.rfind("<link", link)));
+
+    for (int repetition = 0; repetition < 10; repetition++) {
+        try {
+            UrdfModel::fromUrdfStr(xml, threads(4));
+            FAIL("the broken document was accepted");
+        } catch (const URDFParseError& e) {
+            CHECK(e.byteOffset() == serial_offset);
+            CHECK(std::string(e.what()) == serial_message);
+        }
+    }
+
+    // with the link fixed the joint is the first error
+    xml.replace(link, 13, "<mass value=");
+    int joint_offset = static_cast<int>(xml.rfind("<joint", joint));
+    CHECK_THROWS_WITH(UrdfModel::fromUrdfStr(xml, threads(4)), Catch::Contains("wobbly"));
+    try {
+        UrdfModel::fromUrdfStr(xml, threads(4));
+    } catch (const URDFParseError& e) {
+        CHECK(e.byteOffset() == joint_offset);
+    }
+}
+
+TEST_CASE ( "parallel parses from several threads share the worker pool", "[UrdfModel]" ) {
+    std::string xml = wideTreeRobot(300);
+    std::string serial = UrdfModel::fromUrdfStr(xml)->toBinary();
+
+    std::vector<std::string> results(4);
+    std::vector<std::thread> callers;
+    for (size_t t = 0; t < results.size(); t++) {
+        callers.emplace_back([&, t]() {
+            for (int repetition = 0; repetition < 5; repetition++) {
+                results[t] = UrdfModel::fromUrdfStr(xml, threads(4))->toBinary();
+            }
+        });
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+    for (auto& result : results) {
+        CHECK(result == serial);
+    }
+}
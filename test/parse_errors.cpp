@@ -0,0 +1,225 @@
+#include "catch2/catch.hpp"
+#include "urdf/model.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace urdf;
+
+static const char* urdfstr_bad_box =
+    "<robot name=\"r\">\n"
+    "  <link name=\"base\">\n"
+    "    <visual><geometry><box size=\"1 2\"/></geometry></visual>\n"
+    "  </link>\n"
+    "</robot>";
+
+static int offsetOf(const char* xml, const char* part) {
+    return (int) (std::strstr(xml, part) - xml);
+}
+
+TEST_CASE ( "broken documents give the error without throwing", "[ParseError]" ) {
+    const std::vector<std::string> broken = {
+        urdfstr_bad_box,
+        "<robot name=\"r\">\n  <link name=\"a\">\n  </lnk>\n</robot>",
+        "<robot><link name=\"a\"/></robot>",
+        "<robot name=\"r\"><material name=\"m\"/><link name=\"a\"/></robot>",
+        "<robot name=\"r\"><link name=\"a\"/><link name=\"a\"/></robot>",
+        "<robot name=\"r\"><link name=\"a\"><visual><material name=\"m\"><color rgba=\"1 0\"/>"
+        "</material></visual></link></robot>",
+        "<robot name=\"r\"><link name=\"a\"><inertial><mass value=\"x\"/></inertial></link></robot>",
+        "<robot name=\"r\"><link name=\"a\"/><link name=\"b\"/>"
+        "<joint name=\"j\" type=\"bent\"><parent link=\"a\"/><child link=\"b\"/></joint></robot>",
+        "<robot name=\"r\"><link name=\"a\"/><link name=\"b\"/>"
+        "<joint name=\"j\" type=\"revolute\"><parent link=\"a\"/><child link=\"b\"/>"
+        "<limit effort=\"1\"/></joint></robot>",
+        "<robot name=\"r\"><link name=\"a\"/>"
+        "<joint name=\"j\" type=\"fixed\"><parent link=\"a\"/><child link=\"c\"/></joint></robot>",
+        "<robot name=\"r\"><link name=\"a\"/><link name=\"b\"/></robot>",
+    };
+
+    for (bool streaming : { false, true }) {
+        for (unsigned int num_threads : { 1u, 4u }) {
+            ParseOptions options;
+            options.streaming = streaming;
+            options.num_threads = num_threads;
+
+            for (const std::string& xml : broken) {
+                INFO(xml);
+                ParseResult<std::shared_ptr<UrdfModel>> result = UrdfModel::tryFromUrdfStr(xml, options);
+                REQUIRE_FALSE(result.ok());
+                CHECK(result.error().code() != ParseErrorCode::NONE);
+                // same text as the exception, which may be located at the top level element instead
+                CHECK_THROWS_WITH(UrdfModel::fromUrdfStr(xml, options), Catch::StartsWith(result.error().message()));
+                CHECK_THROWS_AS(result.value(), URDFParseError);
+            }
+        }
+    }
+}
+
+TEST_CASE ( "parse errors know their element", "[ParseError]" ) {
+    auto result = UrdfModel::tryFromUrdfStr(urdfstr_bad_box);
+    REQUIRE_FALSE(result);
+    const ParseError& error = result.error();
+    CHECK(error.code() == ParseErrorCode::INVALID_NUMBER);
+    CHECK(error.elementPath() == "/robot/link[@name='base']/visual/geometry/box");
+    CHECK(error.byteOffset() == offsetOf(urdfstr_bad_box, "<box"));
+    CHECK(error.line() == 3);
+    CHECK(error.column() == 23);
+    REQUIRE(error.cause() != nullptr);
+    CHECK(error.cause()->message() == "Parser found 2 elements but 3 expected while parsing vector [1 2]");
+    CHECK(error.message() == "Error while parsing link 'base': box size [1 2] is not a valid: "
+                             "Parser found 2 elements but 3 expected while parsing vector [1 2]!");
+    CHECK_THAT(error.exception().what(), Catch::EndsWith("(line 3, column 23)"));
+
+    const char* two_roots =
+        "<robot name=\"r\">\n"
+        "  <link name=\"a\"/>\n"
+        "  <link name=\"b\"/>\n"
+        "</robot>";
+    for (bool streaming : { false, true }) {
+        ParseOptions options;
+        options.streaming = streaming;
+        result = UrdfModel::tryFromUrdfStr(two_roots, options);
+        REQUIRE_FALSE(result);
+        CHECK(result.error().code() == ParseErrorCode::INVALID_TREE);
+        CHECK(result.error().elementPath() == "/robot/link[@name='b']");
+        CHECK(result.error().byteOffset() == offsetOf(two_roots, "<link name=\"b\""));
+        CHECK(result.error().line() == 3);
+    }
+
+    const char* unknown_link =
+        "<robot name=\"r\">\n"
+        "  <link name=\"a\"/>\n"
+        "  <joint name=\"j\" type=\"fixed\"><parent link=\"a\"/><child link=\"c\"/></joint>\n"
+        "</robot>";
+    result = UrdfModel::tryFromUrdfStr(unknown_link);
+    REQUIRE_FALSE(result);
+    CHECK(result.error().code() == ParseErrorCode::UNKNOWN_LINK);
+    CHECK(result.error().elementPath() == "/robot/joint[@name='j']");
+    CHECK(result.error().byteOffset() == offsetOf(unknown_link, "<joint"));
+    CHECK(result.error().message() == "Error while constructing model! Child link [c] of joint [j] not found");
+
+    const char* duplicate_link = "<robot name=\"r\"><link name=\"a\"/><link name=\"a\"/></robot>";
+    result = UrdfModel::tryFromUrdfStr(duplicate_link);
+    REQUIRE_FALSE(result);
+    CHECK(result.error().code() == ParseErrorCode::DUPLICATE_NAME);
+    CHECK(result.error().byteOffset() == offsetOf(duplicate_link, "<link name=\"a\"/></robot>"));
+
+    const char* bad_xml = "<robot name=\"r\">\n  <link name=\"a\">\n  </lnk>\n</robot>";
+    result = UrdfModel::tryFromUrdfStr(bad_xml);
+    REQUIRE_FALSE(result);
+    CHECK(result.error().code() == ParseErrorCode::XML_SYNTAX);
+    CHECK(result.error().line() == 3);
+    CHECK(result.error().elementPath().empty());
+
+    result = UrdfModel::tryFromUrdfFile("/nonexistent/robot.urdf");
+    REQUIRE_FALSE(result);
+    CHECK(result.error().code() == ParseErrorCode::FILE_ERROR);
+}
+
+TEST_CASE ( "a valid document gives the model", "[ParseError]" ) {
+    const char* xml = "<robot name=\"r\"><link name=\"a\"/><link name=\"b\"/>"
+                      "<joint name=\"j\" type=\"fixed\"><parent link=\"a\"/><child link=\"b\"/></joint></robot>";
+    auto result = UrdfModel::tryFromUrdfStr(xml);
+    REQUIRE(result.ok());
+    CHECK(result.value()->getRoot()->name == "a");
+    CHECK(result.value()->joint_map.size() == 1);
+
+    ParseErrors errors(ParseErrors::FIRST);
+    TiXmlDocument doc;
+    doc.Parse("<robot><link><visual><geometry><sphere radius=\"x\"/></geometry></visual></link></robot>");
+    CHECK(Link::fromXml(doc.RootElement()->FirstChildElement(), errors) == nullptr);
+    // the link has no name either, only the first error is kept but both are counted
+    CHECK(errors.count() == 2);
+    REQUIRE(errors.getErrors().size() == 1);
+    CHECK(errors.getErrors()[0].code() == ParseErrorCode::MISSING_ATTRIBUTE);
+}
+
+TEST_CASE ( "validation reports every error in one pass", "[ParseError]" ) {
+    const char* xml =
+        "<robot name=\"r\">\n"
+        "  <link name=\"a\"><inertial><inertia ixx=\"1\" ixy=\"0\" ixz=\"0\" iyy=\"1\" iyz=\"0\" izz=\"1\"/></inertial></link>\n"
+        "  <link name=\"b\"><visual><geometry><cone radius=\"1\"/></geometry></visual></link>\n"
+        "  <link name=\"c\"/>\n"
+        "  <link name=\"a\"/>\n"
+        "  <joint name=\"j1\" type=\"revolute\"><parent link=\"a\"/><child link=\"b\"/>\n"
+        "    <limit effort=\"x\" velocity=\"1\"/></joint>\n"
+        "  <joint name=\"j2\" type=\"fixed\"><parent link=\"a\"/><child link=\"missing\"/></joint>\n"
+        "  <joint name=\"j3\" type=\"fixed\"><parent link=\"b\"/><child link=\"c\"/></joint>\n"
+        "</robot>";
+
+    std::vector<ParseError> errors = UrdfModel::validateUrdfStr(xml);
+    REQUIRE(errors.size() == 5);
+
+    CHECK(errors[0].code() == ParseErrorCode::MISSING_ELEMENT);
+    CHECK(errors[0].elementPath() == "/robot/link[@name='a']/inertial");
+    CHECK(errors[0].line() == 2);
+    CHECK_THAT(errors[0].message(), Catch::Contains("must have a <mass> element"));
+
+    CHECK(errors[1].code() == ParseErrorCode::INVALID_VALUE);
+    CHECK(errors[1].elementPath() == "/robot/link[@name='b']/visual/geometry/cone");
+    CHECK(errors[1].line() == 3);
+
+    CHECK(errors[2].code() == ParseErrorCode::DUPLICATE_NAME);
+    CHECK(errors[2].line() == 5);
+    CHECK(errors[2].column() == 3);
+
+    CHECK(errors[3].code() == ParseErrorCode::INVALID_NUMBER);
+    CHECK(errors[3].elementPath() == "/robot/joint[@name='j1']/limit");
+    CHECK(errors[3].line() == 7);
+
+    // the broken link b and joint j1 are still part of the link tree, so only
+    // the link that does not exist at all is reported
+    CHECK(errors[4].code() == ParseErrorCode::UNKNOWN_LINK);
+    CHECK(errors[4].elementPath() == "/robot/joint[@name='j2']");
+    CHECK(errors[4].line() == 8);
+
+    for (bool streaming : { false, true }) {
+        for (unsigned int num_threads : { 1u, 4u }) {
+            ParseOptions options;
+            options.streaming = streaming;
+            options.num_threads = num_threads;
+            std::vector<ParseError> again = UrdfModel::validateUrdfStr(xml, options);
+            REQUIRE(again.size() == errors.size());
+            for (size_t i = 0; i < errors.size(); i++) {
+                CHECK(again[i].message() == errors[i].message());
+                CHECK(again[i].byteOffset() == errors[i].byteOffset());
+            }
+        }
+    }
+
+    // the first error of the validation is the one tryFromUrdfStr() stops at
+    auto result = UrdfModel::tryFromUrdfStr(xml);
+    REQUIRE_FALSE(result);
+    CHECK(result.error().message() == errors[0].message());
+
+    CHECK(UrdfModel::validateUrdfStr("<robot name=\"r\"><link name=\"a\"/></robot>").empty());
+    CHECK(UrdfModel::validateUrdfStr("<robot name=\"r\"><link name=\"a\">").size() == 1);
+}
+
+TEST_CASE ( "a link tree with an unconverted element reports no roots", "[ParseError]" ) {
+    // the joint without a name has no placeholder, so a and b both look like roots
+    const char* xml =
+        "<robot name=\"r\"><link name=\"a\"/><link name=\"b\"/>"
+        "<joint type=\"fixed\"><parent link=\"a\"/><child link=\"b\"/></joint></robot>";
+
+    for (bool streaming : { false, true }) {
+        for (unsigned int num_threads : { 1u, 4u }) {
+            ParseOptions options;
+            options.streaming = streaming;
+            options.num_threads = num_threads;
+            std::vector<ParseError> errors = UrdfModel::validateUrdfStr(xml, options);
+            REQUIRE(errors.size() == 1);
+            CHECK_THAT(errors[0].message(), !Catch::Contains("root"));
+            CHECK(errors[0].elementPath() == "/robot/joint");
+        }
+    }
+
+    // the tree is still checked for links that do not exist
+    std::vector<ParseError> errors = UrdfModel::validateUrdfStr(
+        "<robot name=\"r\"><link name=\"a\"/><link name=\"b\"><inertial/></link>"
+        "<joint name=\"j\" type=\"fixed\"><parent link=\"a\"/><child link=\"c\"/></joint></robot>");
+    REQUIRE(errors.size() == 3);
+    CHECK(errors[2].code() == ParseErrorCode::UNKNOWN_LINK);
+}
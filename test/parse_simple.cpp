@@ -4,6 +4,10 @@
 #include <string>
 #include <iostream>
 #include <exception>
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <vector>
 #include "tinyxml/txml.h"
 
 const char* urdfstr_geometry_test =
@@ -201,3 +205,230 @@ TEST_CASE ( "load a two segment model with inertial information", "[UrdfModel]"
     CHECK(joint->dynamics->get()->friction == 0.);
 
 };
+
+TEST_CASE ( "parse numeric attribute strings", "[common]" ) {
+    double values[4];
+    string_view bad_token;
+
+    CHECK(parseDoubles(" 0.1\t-2  +3e1 ", values, 4, &bad_token) == 3);
+    CHECK(bad_token.empty());
+    CHECK(values[0] == 0.1);
+    CHECK(values[1] == -2.);
+    CHECK(values[2] == 30.);
+
+    CHECK(parseDoubles("1 2 x3 4", values, 4, &bad_token) == 2);
+    CHECK(bad_token == "x3");
+
+    double d;
+    CHECK(parseDouble(" 0.25 ", d));
+    CHECK(d == 0.25);
+    CHECK_FALSE(parseDouble("0.25 1", d));
+    CHECK_FALSE(parseDouble("1.0abc", d));
+    CHECK_FALSE(parseDouble("", d));
+
+    Vector3 v = Vector3::fromVecStr("0.7 0.8 0.9");
+    CHECK(v.x == 0.7);
+    CHECK(v.y == 0.8);
+    CHECK(v.z == 0.9);
+    CHECK_THROWS_AS(Vector3::fromVecStr("0.7 0.8"), URDFParseError);
+    CHECK_THROWS_AS(Vector3::fromVecStr("0.7 0.8 a"), URDFParseError);
+    CHECK_THROWS_AS(Color::fromColorStr("0.1 0.2 0.3"), URDFParseError);
+}
+
+TEST_CASE ( "load a urdf file through a memory mapping", "[UrdfModel]" ) {
+    auto path = std::filesystem::temp_directory_path() / "urdf_parser_two_segment.urdf";
+    {
+        std::ofstream out(path);
+        out << urdfstr_two_segment;
+    }
+
+    std::shared_ptr<UrdfModel> model;
+    REQUIRE_NOTHROW(model = UrdfModel::fromUrdfFile(path.string()));
+    std::filesystem::remove(path);
+
+    CHECK(model->getName() == "test");
+    CHECK(model->link_map.size() == 2);
+    CHECK(model->joint_map.size() == 1);
+    REQUIRE(model->getRoot() != nullptr);
+    CHECK(model->getRoot()->name == "link_0");
+
+    CHECK_THROWS_AS(UrdfModel::fromUrdfFile(path.string()), URDFParseError);
+}
+
+TEST_CASE ( "streaming parse matches the DOM based parse", "[UrdfModel]" ) {
+    ParseOptions options;
+    options.streaming = true;
+
+    std::shared_ptr<UrdfModel> dom_model;
+    std::shared_ptr<UrdfModel> model;
+    REQUIRE_NOTHROW(dom_model = UrdfModel::fromUrdfStr(std::string(urdfstr_two_segment)));
+    REQUIRE_NOTHROW(model = UrdfModel::fromUrdfStr(std::string(urdfstr_two_segment), options));
+
+    CHECK(model->getName() == dom_model->getName());
+    CHECK(model->link_map.size() == dom_model->link_map.size());
+    CHECK(model->joint_map.size() == dom_model->joint_map.size());
+    CHECK(model->material_map.size() == dom_model->material_map.size());
+    REQUIRE(model->getRoot() != nullptr);
+    CHECK(model->getRoot()->name == "link_0");
+
+    auto link1 = model->getLink("link_1");
+    REQUIRE(link1 != nullptr);
+    CHECK(link1->getParent() == model->getRoot());
+    CHECK(link1->inertial->mass == 4.);
+    CHECK(link1->visuals.size() == 1);
+    CHECK(model->getLink("link_0")->visuals[0]->material.value() == model->getMaterial("Grey"));
+
+    auto joint = model->getJoint("joint_1");
+    REQUIRE(joint != nullptr);
+    CHECK(joint->limits->get()->upper == 2.96705972839);
+    CHECK(joint->parent_to_joint_transform.position.z == 0.1575);
+
+    // materials defined after the links that use them still resolve
+    const char* late_material =
+        "<robot name=\"late\">"
+        "<link name=\"a\"><visual><geometry><sphere radius=\"1\"/></geometry>"
+        "<material name=\"Red\"/></visual></link>"
+        "<material name=\"Red\"><color rgba=\"1 0 0 1\"/></material>"
+        "</robot>";
+    REQUIRE_NOTHROW(model = UrdfModel::fromUrdfStr(late_material, options));
+    CHECK(model->getMaterial("Red")->color.r == 1.0f);
+
+    const char* duplicate_links =
+        "<robot name=\"dup\"><link name=\"a\"/><link name=\"a\"/></robot>";
+    CHECK_THROWS_AS(UrdfModel::fromUrdfStr(duplicate_links, options), URDFParseError);
+
+    const char* broken_joint =
+        "<robot name=\"broken\"><link name=\"a\"/><joint name=\"j\"/><link name=\"b\"/></robot>";
+    CHECK_THROWS_WITH(UrdfModel::fromUrdfStr(broken_joint, options),
+                      Catch::Contains("has no type"));
+}
+
+TEST_CASE ( "parse attribute values in place", "[UrdfModel]" ) {
+    const char* xml =
+        "<robot name='quoted &amp; escaped'>\n"
+        "  <link name=\"a\"><visual><geometry><sphere radius='0.5'/></geometry></visual></link>\n"
+        "  <link name=\"b&#x41;\"/>\n"
+        "  <joint name=\"j\" type=\"fixed\"><parent link=\"a\"/><child link=\"bA\"/></joint>\n"
+        "</robot>";
+    std::string xml_string(xml);
+
+    std::shared_ptr<UrdfModel> model;
+    REQUIRE_NOTHROW(model = UrdfModel::fromUrdfStr(xml_string));
+    // the caller's string is copied, not parsed in place
+    CHECK(xml_string == xml);
+    CHECK(model->getName() == "quoted & escaped");
+    REQUIRE(model->getLink("bA") != nullptr);
+    CHECK(model->getLink("bA")->getParent() == model->getLink("a"));
+    auto sphere = std::dynamic_pointer_cast<Sphere>(model->getLink("a")->visuals[0]->geometry.value());
+    REQUIRE(sphere != nullptr);
+    CHECK(sphere->radius == 0.5);
+
+    // a read only buffer is parsed directly and left untouched
+    std::vector<char> read_only(xml, xml + std::strlen(xml) + 1);
+    REQUIRE_NOTHROW(model = UrdfModel::fromUrdfBuffer(read_only.data()));
+    CHECK(std::string(read_only.data()) == xml);
+    CHECK(model->getName() == "quoted & escaped");
+    REQUIRE(model->getLink("bA") != nullptr);
+    CHECK(model->getLink("bA")->getParent() == model->getLink("a"));
+
+    // error locations are still reported after values were terminated in place
+    TiXmlDocument doc;
+    std::vector<char> buffer(xml, xml + std::strlen(xml) + 1);
+    buffer[std::strlen(xml) - 2] = '<';
+    doc.ParseInSitu(buffer.data());
+    CHECK(doc.Error());
+    CHECK(doc.ErrorRow() == 5);
+
+    std::vector<char> valid(xml, xml + std::strlen(xml) + 1);
+    doc.ClearError();
+    doc.ParseInSitu(valid.data());
+    REQUIRE_FALSE(doc.Error());
+    TiXmlElement* link = doc.RootElement()->FirstChildElement("link")->NextSiblingElement("link");
+    CHECK(link->Attribute("name") == std::string("bA"));
+    const TiXmlAttribute* radius = doc.RootElement()->FirstChildElement("link")
+        ->FirstChildElement("visual")->FirstChildElement("geometry")
+        ->FirstChildElement("sphere")->FirstAttribute();
+    CHECK(radius->ValueStr() == "0.5");
+    double value = 0;
+    CHECK(radius->QueryDoubleValue(&value) == TIXML_SUCCESS);
+    CHECK(value == 0.5);
+
+    // reading a value as a std::string copies it once and leaves the buffer
+    // pointer alone, so threads can share the DOM
+    std::vector<char> shared(xml, xml + std::strlen(xml) + 1);
+    TiXmlDocument shared_doc;
+    shared_doc.ParseInSitu(shared.data());
+    REQUIRE_FALSE(shared_doc.Error());
+    const TiXmlElement* shared_link = shared_doc.RootElement()->FirstChildElement("link");
+    const char* in_buffer = shared_link->Attribute("name");
+    CHECK(in_buffer == shared.data() + (std::strstr(xml, "\"a\"") + 1 - xml));
+    const std::string& copied = shared_link->FirstAttribute()->ValueStr();
+    CHECK(copied == "a");
+    CHECK(&shared_link->FirstAttribute()->ValueStr() == &copied);
+    REQUIRE(shared_link->Attribute(std::string("name")) != nullptr);
+    CHECK(shared_link->Attribute(std::string("name")) == &copied);
+    CHECK(shared_link->AttributeValue(std::string("name")) == in_buffer);
+    CHECK(shared_link->FirstAttribute()->Value() == in_buffer);
+    CHECK(shared_link->AttributeValue(std::string("missing")) == nullptr);
+}
+
+TEST_CASE ( "fetch several attributes in one pass", "[TinyXML]" ) {
+    TiXmlDocument doc;
+    doc.Parse("<inertia ixx=\"1\" iyy=\"2\" izz=\"3\" ixy=\"0\"/>");
+    REQUIRE_FALSE(doc.Error());
+
+    const char* const names[4] = { "izz", "ixx", "ixz", "iyy" };
+    const char* values[4];
+    CHECK(doc.RootElement()->Attributes(names, values, 4) == 3);
+    CHECK(values[0] == std::string("3"));
+    CHECK(values[1] == std::string("1"));
+    CHECK(values[2] == nullptr);
+    CHECK(values[3] == std::string("2"));
+
+    const char* missing_inertia =
+        "<robot name=\"r\"><link name=\"a\"><inertial><mass value=\"1\"/>"
+        "<inertia ixx=\"1\" ixy=\"0\" ixz=\"0\" iyy=\"1\" iyz=\"0\"/></inertial></link></robot>";
+    CHECK_THROWS_WITH(UrdfModel::fromUrdfStr(missing_inertia),
+                      Catch::Contains("must have ixx,ixy,ixz,iyy,iyz,izz attributes"));
+}
+
+TEST_CASE ( "errors are located with and without location tracking", "[UrdfModel]" ) {
+    const char* bad_joint =
+        "<robot name=\"r\">\n"
+        "\t<link name=\"a\"/>\n"
+        "  <link name=\"b\"/>\n"
+        "  <joint name=\"j\" type=\"fixed\"><parent link=\"a\"/><child link=\"b\"/></joint>\n"
+        "  <joint name=\"k\"><parent link=\"a\"/><child link=\"b\"/></joint>\n"
+        "</robot>";
+    const char* bad_xml =
+        "<robot name=\"r\">\n"
+        "  <link name=\"a\">\n"
+        "  </lnk>\n"
+        "</robot>";
+
+    for (bool streaming : { false, true }) {
+        for (bool track_locations : { true, false }) {
+            ParseOptions options;
+            options.streaming = streaming;
+            options.track_locations = track_locations;
+
+            try {
+                UrdfModel::fromUrdfStr(bad_joint, options);
+                FAIL("the joint without a type was accepted");
+            } catch (const URDFParseError& e) {
+                CHECK(e.line() == 5);
+                CHECK(e.column() == 3);
+                CHECK(e.byteOffset() == (int) (std::strstr(bad_joint, "<joint name=\"k\"") - bad_joint));
+                CHECK_THAT(e.what(), Catch::EndsWith("(line 5, column 3)"));
+            }
+
+            try {
+                UrdfModel::fromUrdfStr(bad_xml, options);
+                FAIL("the mismatched end tag was accepted");
+            } catch (const URDFParseError& e) {
+                CHECK(e.line() == 3);
+                CHECK(e.byteOffset() >= 0);
+            }
+        }
+    }
+}
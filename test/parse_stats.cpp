@@ -0,0 +1,69 @@
+#include "catch2/catch.hpp"
+#include "urdf/model.h"
+
+#include <string>
+
+using namespace urdf;
+
+// 12 elements with 11 attributes
+static const char* urdfstr_counted =
+    "<robot name=\"stats\">\n"
+    "  <material name=\"blue\"><color rgba=\"0 0 1 1\"/></material>\n"
+    "  <link name=\"base\">\n"
+    "    <visual><geometry><box size=\"1 1 1\"/></geometry><material name=\"blue\"/></visual>\n"
+    "  </link>\n"
+    "  <link name=\"arm\"/>\n"
+    "  <joint name=\"j\" type=\"fixed\"><parent link=\"base\"/><child link=\"arm\"/></joint>\n"
+    "</robot>";
+
+static void checkCounts(const ParseStats& stats) {
+    CHECK(stats.bytes == std::string(urdfstr_counted).size());
+    CHECK(stats.elements == 12);
+    CHECK(stats.attributes == 11);
+    CHECK(stats.allocations > 0);
+    CHECK(stats.materials == 1);
+    CHECK(stats.links == 2);
+    CHECK(stats.joints == 1);
+
+    double phases = stats.xml_seconds + stats.material_seconds + stats.link_seconds +
+                    stats.material_resolution_seconds + stats.joint_seconds +
+                    stats.link_tree_seconds + stats.origin_matrix_seconds;
+    CHECK(stats.xml_seconds >= 0.);
+    CHECK(stats.total_seconds > 0.);
+    CHECK(phases <= stats.total_seconds * 1.01 + 1e-6);
+}
+
+TEST_CASE ( "parse statistics count the document and time the phases", "[ParseStats]" ) {
+    const std::string xml(urdfstr_counted);
+    ParseStats stats;
+    REQUIRE(UrdfModel::fromUrdfStr(xml, ParseOptions(), &stats) != nullptr);
+
+    if (!ParseStats::enabled) {
+        CHECK(stats.total_seconds == 0.);
+        CHECK(stats.elements == 0);
+        CHECK(stats.bytes == 0);
+        return;
+    }
+
+    checkCounts(stats);
+    CHECK(stats.origin_matrix_seconds == 0.);
+
+    ParseOptions streaming;
+    streaming.streaming = true;
+    ParseStats streamed;
+    REQUIRE(UrdfModel::fromUrdfStr(xml, streaming, &streamed) != nullptr);
+    checkCounts(streamed);
+    // one heap block per element and attribute when there is no arena
+    CHECK(streamed.allocations == 23);
+
+    // the stats are reset by every parse rather than summed up
+    ParseOptions cached;
+    cached.cache_origin_matrices = true;
+    REQUIRE(UrdfModel::fromUrdfStr(xml, cached, &stats) != nullptr);
+    checkCounts(stats);
+
+    ParseOptions parallel;
+    parallel.num_threads = 4;
+    REQUIRE(UrdfModel::fromUrdfStr(xml, parallel, &stats) != nullptr);
+    checkCounts(stats);
+}
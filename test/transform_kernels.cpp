@@ -0,0 +1,111 @@
+#include "catch2/catch.hpp"
+#include "urdf/common.h"
+#include "urdf/model.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace urdf;
+
+// rotation through two quaternion products, as Rotation::operator* used to do it
+static Vector3 referenceRotate(const Rotation& q, const Vector3& v) {
+    Rotation t = q * (Rotation(v.x, v.y, v.z, 0.) * q.getInverse());
+    return Vector3(t.x, t.y, t.z);
+}
+
+static void checkClose(const Vector3& a, const Vector3& b) {
+    CHECK(a.x == Approx(b.x).margin(1e-12));
+    CHECK(a.y == Approx(b.y).margin(1e-12));
+    CHECK(a.z == Approx(b.z).margin(1e-12));
+}
+
+TEST_CASE ( "rotate vectors and compose transforms", "[common]" ) {
+    Rotation q = Rotation::fromRpy(0.3, -1.1, 2.4);
+    Vector3 v(0.5, -2., 3.25);
+    checkClose(q * v, referenceRotate(q, v));
+
+    // quaternions that are not normalized still rotate
+    Rotation scaled(2. * q.x, 2. * q.y, 2. * q.z, 2. * q.w);
+    checkClose(scaled * v, referenceRotate(q, v));
+    checkClose(Rotation(0., 0., 0., 0.) * v, Vector3(0., 0., 0.));
+
+    Transform a(Vector3(1., 2., 3.), q);
+    Transform b(Vector3(-0.5, 0.25, 4.), Rotation::fromRpy(1.2, 0.1, -0.7));
+    checkClose((a * b) * v, a * (b * v));
+
+    Transform identity = a * a.getInverse();
+    checkClose(identity.position, Vector3(0., 0., 0.));
+    CHECK(std::fabs(identity.rotation.w) == Approx(1.));
+    checkClose(a.getInverse() * (a * v), v);
+}
+
+TEST_CASE ( "batch kernels match the single element operators", "[common]" ) {
+    const size_t count = 37;
+    std::vector<Vector3> points(count);
+    std::vector<Transform> a(count), b(count);
+    for (size_t i = 0; i < count; i++) {
+        points[i] = Vector3(std::sin(i), std::cos(3. * i), 0.1 * i);
+        a[i] = Transform(Vector3(i, -1., 0.5 * i), Rotation::fromRpy(0.1 * i, 0.2, -0.05 * i));
+        b[i] = Transform(Vector3(0., 2., -1.), Rotation::fromRpy(-0.3, 0.07 * i, 1.));
+    }
+
+    Transform transform(Vector3(1., 2., 3.), Rotation::fromRpy(0.3, -1.1, 2.4));
+    std::vector<Vector3> rotated(count), moved(count);
+    rotateVectors(transform.rotation, points.data(), rotated.data(), count);
+    transformPoints(transform, points.data(), moved.data(), count);
+
+    std::vector<Transform> composed(count), inverted(count);
+    composeTransforms(a.data(), b.data(), composed.data(), count);
+    invertTransforms(a.data(), inverted.data(), count);
+
+    for (size_t i = 0; i < count; i++) {
+        checkClose(rotated[i], transform.rotation * points[i]);
+        checkClose(moved[i], transform * points[i]);
+        checkClose(composed[i] * points[i], a[i] * (b[i] * points[i]));
+        checkClose(inverted[i] * (a[i] * points[i]), points[i]);
+    }
+
+    // in place
+    std::vector<Vector3> in_place = points;
+    transformPoints(transform, in_place.data(), in_place.data(), count);
+    for (size_t i = 0; i < count; i++) {
+        checkClose(in_place[i], moved[i]);
+    }
+}
+
+TEST_CASE ( "cached origin matrices match their transforms", "[common]" ) {
+    Transform a(Vector3(1., 2., 3.), Rotation::fromRpy(0.3, -1.1, 2.4));
+    Transform b(Vector3(-0.5, 0.25, 4.), Rotation::fromRpy(1.2, 0.1, -0.7));
+    Matrix3x4 ma = Matrix3x4::fromTransform(a);
+    Matrix3x4 mb = Matrix3x4::fromTransform(b);
+    Vector3 v(0.5, -2., 3.25);
+    checkClose(ma * v, a * v);
+    checkClose((ma * mb) * v, (a * b) * v);
+    checkClose(Matrix3x4() * v, v);
+
+    const char* xml =
+        "<robot name=\"r\">"
+        "<link name=\"a\"><inertial><origin xyz=\"0 0 1\"/><mass value=\"1\"/>"
+        "<inertia ixx=\"1\" ixy=\"0\" ixz=\"0\" iyy=\"1\" iyz=\"0\" izz=\"1\"/></inertial>"
+        "<visual><origin rpy=\"0 0 1.5707963267948966\"/><geometry><sphere radius=\"1\"/></geometry></visual>"
+        "<collision><origin xyz=\"1 0 0\"/><geometry><sphere radius=\"1\"/></geometry></collision></link>"
+        "<link name=\"b\"/>"
+        "<joint name=\"j\" type=\"fixed\"><parent link=\"a\"/><child link=\"b\"/><origin xyz=\"0 2 0\"/></joint>"
+        "</robot>";
+
+    auto plain = UrdfModel::fromUrdfStr(xml);
+    CHECK_FALSE(plain->getJoint("j")->parent_to_joint_matrix.has_value());
+
+    ParseOptions options;
+    options.cache_origin_matrices = true;
+    auto model = UrdfModel::fromUrdfStr(xml, options);
+    auto link = model->getLink("a");
+    REQUIRE(link->inertial->origin_matrix.has_value());
+    CHECK(link->inertial->origin_matrix->m[11] == 1.);
+    REQUIRE(link->visuals[0]->origin_matrix.has_value());
+    checkClose(link->visuals[0]->origin_matrix.value() * v, link->visuals[0]->origin * v);
+    REQUIRE(link->collisions[0]->origin_matrix.has_value());
+    CHECK(link->collisions[0]->origin_matrix->m[3] == 1.);
+    REQUIRE(model->getJoint("j")->parent_to_joint_matrix.has_value());
+    CHECK(model->getJoint("j")->parent_to_joint_matrix->m[7] == 2.);
+}
@@ -0,0 +1,86 @@
+#include "catch2/catch.hpp"
+#include "urdf/model.h"
+#include "urdf/value_model.h"
+
+#include <string>
+
+static const char* urdfstr_shapes =
+    "<robot name=\"shapes\">\n"
+    "  <material name=\"blue\"><color rgba=\"0 0 0.8 1\"/></material>\n"
+    "  <link name=\"base\">\n"
+    "    <inertial><mass value=\"2.5\"/><inertia ixx=\"1\" ixy=\"0\" ixz=\"0\" iyy=\"2\" iyz=\"0\" izz=\"3\"/></inertial>\n"
+    "    <visual name=\"body\"><origin xyz=\"1 2 3\"/><geometry><box size=\"1 2 3\"/></geometry><material name=\"blue\"/></visual>\n"
+    "    <visual><geometry><mesh filename=\"base.stl\" scale=\"2 2 2\"/></geometry>\n"
+    "      <material name=\"red\"><color rgba=\"1 0 0 1\"/></material></visual>\n"
+    "    <collision><geometry><cylinder length=\"0.5\" radius=\"0.1\"/></geometry></collision>\n"
+    "    <collision><geometry><capsule length=\"0.4\" radius=\"0.2\"/></geometry></collision>\n"
+    "  </link>\n"
+    "  <link name=\"arm\"><collision><geometry><sphere radius=\"0.05\"/></geometry></collision></link>\n"
+    "  <link name=\"finger\"/>\n"
+    "  <joint name=\"grip\" type=\"prismatic\">\n"
+    "    <parent link=\"arm\"/><child link=\"finger\"/>\n"
+    "    <limit effort=\"1\" velocity=\"1\"/><mimic joint=\"shoulder\" multiplier=\"2\"/>\n"
+    "  </joint>\n"
+    "  <joint name=\"shoulder\" type=\"revolute\">\n"
+    "    <parent link=\"base\"/><child link=\"arm\"/><origin xyz=\"0 0 1\"/><axis xyz=\"0 1 0\"/>\n"
+    "    <limit lower=\"-1\" upper=\"1\" effort=\"10\" velocity=\"2\"/><dynamics damping=\"0.3\"/>\n"
+    "  </joint>\n"
+    "</robot>";
+
+using namespace urdf;
+
+TEST_CASE ( "convert a model into the value form", "[ValueModel]" ) {
+    std::shared_ptr<UrdfModel> model = UrdfModel::fromUrdfStr(std::string(urdfstr_shapes));
+    ValueModel values = ValueModel::fromUrdfModel(*model);
+
+    CHECK(values.name == "shapes");
+    REQUIRE(values.links.size() == 3);
+    REQUIRE(values.joints.size() == 2);
+    CHECK(values.links[0].name == "base");
+    CHECK(values.links[0].parent_link == -1);
+    CHECK(values.linkIndex("arm") == 1);
+    CHECK(values.linkIndex("finger") == 2);
+    CHECK(values.linkIndex("wrist") == -1);
+    CHECK(values.links[2].parent_link == 1);
+    CHECK(values.links[2].parent_joint == values.jointIndex("grip"));
+    CHECK(values.links[1].child_links == std::vector<int>{ 2 });
+
+    const LinkValue& base = values.links[0];
+    REQUIRE(base.inertial.has_value());
+    CHECK(base.inertial->iyy == 2.);
+    REQUIRE(base.visuals.size() == 2);
+    CHECK(base.visuals[0].name == "body");
+    CHECK(base.visuals[0].origin.position.y == 2.);
+    REQUIRE(std::holds_alternative<Box>(base.visuals[0].geometry.value()));
+    CHECK(std::get<Box>(base.visuals[0].geometry.value()).dim.z == 3.);
+    CHECK(base.visuals[0].geometry->index() == GeometryType::BOX);
+    CHECK(values.materials[base.visuals[0].material].name == "blue");
+    CHECK(values.materials[base.visuals[1].material].color.r == 1.f);
+    CHECK(values.materialIndex("red") == base.visuals[1].material);
+    CHECK(std::get<Mesh>(base.visuals[1].geometry.value()).filename == "base.stl");
+    REQUIRE(base.collisions.size() == 2);
+    CHECK(std::get<Cylinder>(base.collisions[0].geometry.value()).length == 0.5);
+    CHECK(std::get<Capsule>(base.collisions[1].geometry.value()).radius == 0.2);
+    CHECK(std::get<Sphere>(values.links[1].collisions[0].geometry.value()).radius == 0.05);
+    CHECK(values.links[2].visuals.empty());
+
+    const JointValue& shoulder = values.joints[values.jointIndex("shoulder")];
+    CHECK(shoulder.type == JointType::REVOLUTE);
+    CHECK(shoulder.parent_link == 0);
+    CHECK(shoulder.child_link == 1);
+    CHECK(shoulder.axis.y == 1.);
+    CHECK(shoulder.limits->upper == 1.);
+    CHECK(shoulder.dynamics->damping == 0.3);
+    CHECK_FALSE(shoulder.mimic.has_value());
+    const JointValue& grip = values.joints[values.jointIndex("grip")];
+    CHECK(grip.mimic->joint_name == "shoulder");
+    CHECK_FALSE(grip.dynamics.has_value());
+
+    // a copy does not share anything with the original
+    ValueModel copy = values;
+    std::get<Box>(*copy.links[0].visuals[0].geometry).dim.x = 5.;
+    copy.joints[0].limits->upper = 9.;
+    CHECK(std::get<Box>(*values.links[0].visuals[0].geometry).dim.x == 1.);
+    CHECK(values.joints[0].limits->upper != 9.);
+    CHECK(copy.linkIndex("arm") == 1);
+}